@@ -3,12 +3,22 @@
 #ifndef OFXBBBSNIPETS_H
 #define OFXBBBSNIPETS_H
 
+#include "ofxClock.h"
 #include "ofxLimitedLife.h"
 #include "ofxObservable.h"
 #include "ofxInlineStaticVariable.h"
+#include "ofxEasing.h"
 #include "ofxCrossFade.h"
+#include "ofxCrossFadeScheduler.h"
+#include "ofxCrossFadePixels.h"
+#include "ofxInplaceFunction.h"
 #include "ofxSwitchExecutor.h"
+#include "ofxLockFreeQueue.h"
+#include "ofxBitmapConsoleSpool.h"
 #include "ofxBitmapConsole.h"
+#include "ofxBitmapConsoleLoggerChannel.h"
+#include "ofxFboPool.h"
+#include "ofxFboReadback.h"
 #include "ofxPingPongFbo.h"
 #include "ofxAlertError.h"
 #include "ofxGLFWUtils.h"
@@ -8,9 +8,22 @@
 #define ofxBitmapConsole_h
 
 #include "ofUtils.h"
+#include "ofGraphics.h"
+#include "ofBitmapFont.h"
+#include "ofMesh.h"
+#include "ofxClock.h"
+#include "ofxLockFreeQueue.h"
+#include "ofxBitmapConsoleSpool.h"
 
 #include <algorithm>
-#include <regex>
+#include <charconv>
+#include <cstdio>
+#include <deque>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 
 namespace ofx {
     struct BitmapConsole {
@@ -18,6 +31,9 @@ namespace ofx {
             Settings()
             : max_lines{0}
             , num_fold{0}
+            , capacity{0}
+            , queue_capacity{1024}
+            , arena_chunk_size{0}
             , is_reversed{false}
             {};
             
@@ -28,6 +44,16 @@ namespace ofx {
             
             std::size_t max_lines{0};
             std::size_t num_fold{0};
+            std::size_t capacity{0}; // 0 means growable
+            std::size_t queue_capacity{1024}; // 0 means post() is disabled
+            std::size_t arena_chunk_size{0}; // 0 means one allocation per line
+            bool use_search_index{false};
+            std::size_t coalesce_window{0}; // 0 means no coalescing
+            float rate_limit{0.0f}; // lines per second per tag. 0 means unlimited
+            float rate_limit_burst{0.0f};
+            std::string spool_path{""}; // empty means no spool
+            std::size_t spool_max_bytes{0};
+            std::size_t spool_num_replay{0};
             bool is_reversed{false};
             
             Settings &maxLines(std::size_t max_lines) {
@@ -38,6 +64,51 @@ namespace ofx {
                 this->num_fold = num_fold;
                 return *this;
             }
+            // fixed number of entries kept in ring buffer. when full, oldest entry is evicted.
+            Settings &fixedCapacity(std::size_t capacity) {
+                this->capacity = capacity;
+                return *this;
+            }
+            // number of lines post() can hold until next update()
+            Settings &queueCapacity(std::size_t queue_capacity) {
+                this->queue_capacity = queue_capacity;
+                return *this;
+            }
+            // texts are packed into chunks of this size and chunks are freed in bulk
+            // when all of their lines are evicted.
+            Settings &arenaChunkSize(std::size_t arena_chunk_size) {
+                this->arena_chunk_size = arena_chunk_size;
+                return *this;
+            }
+            // lines are also written into memory mapped file at path (rotated to path + ".1"
+            // when max_bytes is exceeded, see ofxBitmapConsoleSpool). setup() replays last num_replay lines
+            // with their tags from them. POSIX only.
+            Settings &spool(const std::string &path,
+                            std::size_t max_bytes = 4 * 1024 * 1024,
+                            std::size_t num_replay = 100)
+            {
+                spool_path = path;
+                spool_max_bytes = max_bytes;
+                spool_num_replay = num_replay;
+                return *this;
+            }
+            // maintains trigram / tag index for setFilter
+            Settings &searchIndex(bool use_search_index) {
+                this->use_search_index = use_search_index;
+                return *this;
+            }
+            // same line as one of the last window entries is not added but
+            // counted up on that entry (drawn with " (xN)"). 1 means consecutive duplicates only.
+            Settings &coalesce(std::size_t window) {
+                coalesce_window = window;
+                return *this;
+            }
+            // new lines of each tag are dropped when they exceed lines_per_second (with burst)
+            Settings &rateLimit(float lines_per_second, float burst = 10.0f) {
+                rate_limit = lines_per_second;
+                rate_limit_burst = burst;
+                return *this;
+            }
             Settings &reverse(bool is_reversed) {
                 this->is_reversed = is_reversed;
                 return *this;
@@ -45,6 +116,10 @@ namespace ofx {
         };
         
         struct Line {
+            Line()
+            : Line{""}
+            {};
+            
             Line(const std::string &text)
             : text{text}
             , num_lines{count_lines(text)}
@@ -64,116 +139,812 @@ namespace ofx {
             , fg_color{fg}
             {};
             
-            static std::size_t count_lines(const std::string &text) {
+            static std::size_t count_lines(std::string_view text) {
                 return std::count(text.begin(), text.end(), '\n') + 1;
             }
             
+            Line &tagged(const std::string &tag) {
+                this->tag = tag;
+                return *this;
+            }
+            
             std::string text;
             std::size_t num_lines;
             bool highlighted{false};
             ofColor bg_color{};
             ofColor fg_color{};
+            std::string tag{""};
+        };
+        
+        // append only text storage. chunks are released from the oldest one
+        // when all texts stored in it were released.
+        struct TextArena {
+            static constexpr std::uint64_t no_chunk = std::numeric_limits<std::uint64_t>::max();
+            
+            void setup(std::size_t chunk_size) {
+                clear();
+                this->chunk_size = chunk_size;
+            }
+            
+            void clear() {
+                chunks.clear();
+                spare = Chunk{};
+                front_id = 0;
+                reserved_bytes = 0;
+                used_bytes = 0;
+            }
+            
+            // stores head and tail contiguously
+            std::string_view store(std::string_view head, std::string_view tail, std::uint64_t &chunk_id) {
+                const std::size_t size = head.size() + tail.size();
+                if(size == 0) {
+                    chunk_id = no_chunk;
+                    return {};
+                }
+                if(chunks.empty() || chunks.back().size - chunks.back().used < size) {
+                    allocate(size);
+                }
+                Chunk &chunk = chunks.back();
+                char *data = chunk.data.get() + chunk.used;
+                std::copy(tail.begin(), tail.end(), std::copy(head.begin(), head.end(), data));
+                chunk.used += size;
+                ++chunk.num_alive;
+                used_bytes += size;
+                chunk_id = front_id + chunks.size() - 1;
+                return {data, size};
+            }
+            
+            void release(std::uint64_t chunk_id, std::size_t length) {
+                if(chunk_id == no_chunk) return;
+                --chunks[chunk_id - front_id].num_alive;
+                used_bytes -= length;
+                while(!chunks.empty() && chunks.front().num_alive == 0) {
+                    Chunk &chunk = chunks.front();
+                    if(chunk.size == chunk_size && !spare.data) {
+                        chunk.used = 0;
+                        spare = std::move(chunk);
+                    } else {
+                        reserved_bytes -= chunk.size;
+                    }
+                    chunks.pop_front();
+                    ++front_id;
+                }
+            }
+            
+            std::size_t reservedBytes() const
+            { return reserved_bytes; }
+            std::size_t usedBytes() const
+            { return used_bytes; }
+            std::size_t numChunks() const
+            { return chunks.size() + (spare.data ? 1 : 0); }
+            
+        protected:
+            struct Chunk {
+                std::unique_ptr<char[]> data;
+                std::size_t size{0};
+                std::size_t used{0};
+                std::size_t num_alive{0};
+            };
+            
+            void allocate(std::size_t required_size) {
+                if(spare.data && required_size <= spare.size) {
+                    chunks.push_back(std::move(spare));
+                    spare = Chunk{};
+                    return;
+                }
+                Chunk chunk;
+                chunk.size = std::max(chunk_size, required_size);
+                chunk.data.reset(new char[chunk.size]);
+                reserved_bytes += chunk.size;
+                chunks.push_back(std::move(chunk));
+            }
+            
+            std::deque<Chunk> chunks;
+            Chunk spare;
+            std::uint64_t front_id{0};
+            std::size_t chunk_size{0};
+            std::size_t reserved_bytes{0};
+            std::size_t used_bytes{0};
+        };
+        
+        // stored form of Line. tag and text refer to TextArena.
+        struct Entry {
+            std::string_view text{};
+            std::string_view tag{};
+            std::uint64_t chunk_id{TextArena::no_chunk};
+            std::size_t num_lines{0};
+            bool highlighted{false};
+            ofColor bg_color{};
+            ofColor fg_color{};
+            std::uint64_t hash{0}; // only used when coalescing
+            std::uint32_t num_repeats{1};
+            float last_seen{0.0f};
+        };
+        
+        struct MemoryFootprint {
+            std::size_t text_reserved{0};
+            std::size_t text_used{0};
+            std::size_t entries{0};
+            std::size_t index{0};
+            
+            std::size_t total() const
+            { return text_reserved + entries + index; }
+        };
+        
+        static std::uint64_t fnv1a(std::string_view str, std::uint64_t h = 14695981039346656037ull) {
+            for(char c : str) {
+                h ^= static_cast<unsigned char>(c);
+                h *= 1099511628211ull;
+            }
+            return h;
+        }
+        
+        // trigram and tag postings of entry ids. ids are added in increasing order
+        // and removed from the oldest, so each posting list is a deque.
+        struct SearchIndex {
+            void clear() {
+                trigrams.clear();
+                tags.clear();
+            }
+            
+            void add(std::uint64_t id, std::string_view tag, std::string_view text) {
+                for(auto key : unique_trigrams(text)) trigrams[key].push_back(id);
+                if(!tag.empty()) tags[hash(tag)].push_back(id);
+            }
+            
+            void remove(std::uint64_t id, std::string_view tag, std::string_view text) {
+                for(auto key : unique_trigrams(text)) pop(trigrams, key, id);
+                if(!tag.empty()) pop(tags, hash(tag), id);
+            }
+            
+            // returns posting list which contains all ids matching to tag and substring.
+            // (may contain false positives.) nullptr means "index can't narrow down".
+            const std::deque<std::uint64_t> *candidates(std::string_view tag, std::string_view substring) const {
+                static const std::deque<std::uint64_t> empty_list;
+                const std::deque<std::uint64_t> *shortest = nullptr;
+                auto narrow = [&](const auto &postings, std::uint64_t key) {
+                    auto it = postings.find(key);
+                    const auto *list = (it == postings.end()) ? &empty_list : &it->second;
+                    if(!shortest || list->size() < shortest->size()) shortest = list;
+                };
+                if(!tag.empty()) narrow(tags, hash(tag));
+                for(std::size_t i = 0; i + 3 <= substring.size(); ++i) {
+                    narrow(trigrams, trigram(substring.data() + i));
+                }
+                return shortest;
+            }
+            
+            std::size_t memoryFootprint() const {
+                std::size_t size = 0;
+                for(const auto &posting : trigrams) size += sizeof(posting) + posting.second.size() * sizeof(std::uint64_t);
+                for(const auto &posting : tags) size += sizeof(posting) + posting.second.size() * sizeof(std::uint64_t);
+                return size;
+            }
+            
+        protected:
+            using postings_t = std::unordered_map<std::uint64_t, std::deque<std::uint64_t>>;
+            
+            static std::uint64_t trigram(const char *str) {
+                return (std::uint64_t(static_cast<unsigned char>(str[0])) << 16)
+                     | (std::uint64_t(static_cast<unsigned char>(str[1])) << 8)
+                     | std::uint64_t(static_cast<unsigned char>(str[2]));
+            }
+            
+            static std::uint64_t hash(std::string_view str)
+            { return fnv1a(str); }
+            
+            const std::vector<std::uint64_t> &unique_trigrams(std::string_view text) {
+                keys.clear();
+                for(std::size_t i = 0; i + 3 <= text.size(); ++i) keys.push_back(trigram(text.data() + i));
+                std::sort(keys.begin(), keys.end());
+                keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+                return keys;
+            }
+            
+            static void pop(postings_t &postings, std::uint64_t key, std::uint64_t id) {
+                auto it = postings.find(key);
+                if(it == postings.end()) return;
+                if(!it->second.empty() && it->second.front() == id) it->second.pop_front();
+                if(it->second.empty()) postings.erase(it);
+            }
+            
+            postings_t trigrams;
+            postings_t tags;
+            std::vector<std::uint64_t> keys;
+        };
+        
+        struct Filter {
+            std::string tag{""};
+            std::string substring{""};
+            
+            bool empty() const
+            { return tag.empty() && substring.empty(); }
+            bool matches(const Entry &entry) const {
+                return (tag.empty() || entry.tag == tag)
+                    && (substring.empty() || entry.text.find(substring) != std::string_view::npos);
+            }
+        };
+        
+        // ring buffer of Entry with running total of num_lines.
+        // push_back / pop_front are O(1) (amortized when growable).
+        // num_lines of each slot is also indexed by fenwick tree,
+        // so findEntry (line offset -> entry) is O(log n).
+        struct LineStorage {
+            void reset(std::size_t fixed_capacity, std::size_t arena_chunk_size) {
+                arena.setup(arena_chunk_size);
+                slots.clear();
+                slots.shrink_to_fit();
+                slots.reserve(fixed_capacity);
+                capacity = fixed_capacity;
+                head = 0;
+                count = 0;
+                total_lines = 0;
+                rebuild_index();
+            }
+            
+            void clear() {
+                arena.clear();
+                front_id += count;
+                slots.clear();
+                head = 0;
+                count = 0;
+                total_lines = 0;
+                rebuild_index();
+            }
+            
+            bool full() const
+            { return 0 < capacity && count == capacity; }
+            
+            void push_back(std::string_view text,
+                           std::string_view tag,
+                           bool highlighted,
+                           const ofColor &bg_color,
+                           const ofColor &fg_color)
+            {
+                if(full()) pop_front();
+                Entry line;
+                const auto stored = arena.store(tag, text, line.chunk_id);
+                line.tag = stored.substr(0, tag.size());
+                line.text = stored.substr(tag.size());
+                line.num_lines = Line::count_lines(text);
+                line.highlighted = highlighted;
+                line.bg_color = bg_color;
+                line.fg_color = fg_color;
+                total_lines += line.num_lines;
+                const std::size_t num_lines = line.num_lines;
+                if(count < slots.size()) {
+                    const std::size_t p = physical(count);
+                    slots[p] = std::move(line);
+                    ++count;
+                    add_to_index(p, num_lines);
+                } else {
+                    bool needs_rebuild = false;
+                    if(head != 0) {
+                        std::rotate(slots.begin(), slots.begin() + head, slots.end());
+                        head = 0;
+                        needs_rebuild = true;
+                    }
+                    slots.push_back(std::move(line));
+                    ++count;
+                    if(needs_rebuild || index.size() != slots.capacity() + 1) {
+                        rebuild_index();
+                    } else {
+                        add_to_index(slots.size() - 1, num_lines);
+                    }
+                }
+            }
+            
+            void pop_front() {
+                if(count == 0) return;
+                Entry &line = slots[head];
+                total_lines -= line.num_lines;
+                add_to_index(head, -line.num_lines);
+                arena.release(line.chunk_id, line.tag.size() + line.text.size());
+                line = Entry{};
+                head = (head + 1) % slots.size();
+                --count;
+                ++front_id;
+            }
+            
+            const Entry &operator[](std::size_t n) const
+            { return slots[physical(n)]; }
+            Entry &operator[](std::size_t n)
+            { return slots[physical(n)]; }
+            
+            const Entry &front() const
+            { return (*this)[0]; }
+            const Entry &back() const
+            { return (*this)[count - 1]; }
+            
+            bool empty() const
+            { return count == 0; }
+            std::size_t size() const
+            { return count; }
+            std::size_t numLines() const
+            { return total_lines; }
+            
+            // serial number of the front entry. n-th entry's id is frontId() + n.
+            std::uint64_t frontId() const
+            { return front_id; }
+            
+            MemoryFootprint memoryFootprint() const {
+                MemoryFootprint footprint;
+                footprint.text_reserved = arena.reservedBytes();
+                footprint.text_used = arena.usedBytes();
+                footprint.entries = slots.capacity() * sizeof(Entry);
+                footprint.index = index.capacity() * sizeof(std::size_t);
+                return footprint;
+            }
+            
+            // returns index of entry which contains line_offset-th line counted from front.
+            // returns size() if line_offset is out of range.
+            std::size_t findEntry(std::size_t line_offset) const {
+                if(total_lines <= line_offset) return count;
+                const std::size_t lines_before_head = prefix_sum(head);
+                const std::size_t lines_from_head = prefix_sum(slots.size()) - lines_before_head;
+                const std::size_t p = (line_offset < lines_from_head)
+                    ? lower_bound(lines_before_head + line_offset)
+                    : lower_bound(line_offset - lines_from_head);
+                return (p + slots.size() - head) % slots.size();
+            }
+            
+            // returns sum of num_lines of entries in [0, n)
+            std::size_t numLinesBefore(std::size_t n) const {
+                if(count <= n) return total_lines;
+                const std::size_t p = physical(n);
+                const std::size_t lines_before_head = prefix_sum(head);
+                return (head <= p)
+                    ? prefix_sum(p) - lines_before_head
+                    : prefix_sum(slots.size()) - lines_before_head + prefix_sum(p);
+            }
+            
+        protected:
+            std::size_t physical(std::size_t n) const
+            { return (head + n) % slots.size(); }
+            
+            // fenwick tree over physical slots. (1-origin, index[0] is unused)
+            void rebuild_index() {
+                index.assign(slots.capacity() + 1, 0);
+                for(std::size_t n = 0; n < count; ++n) {
+                    index[physical(n) + 1] = slots[physical(n)].num_lines;
+                }
+                for(std::size_t i = 1; i < index.size(); ++i) {
+                    const std::size_t parent = i + (i & (~i + 1));
+                    if(parent < index.size()) index[parent] += index[i];
+                }
+            }
+            
+            // unsigned wrap-around makes negative delta work
+            void add_to_index(std::size_t p, std::size_t delta) {
+                for(std::size_t i = p + 1; i < index.size(); i += i & (~i + 1)) {
+                    index[i] += delta;
+                }
+            }
+            
+            // sum of physical slots [0, p)
+            std::size_t prefix_sum(std::size_t p) const {
+                std::size_t sum = 0;
+                for(std::size_t i = p; 0 < i; i -= i & (~i + 1)) {
+                    sum += index[i];
+                }
+                return sum;
+            }
+            
+            // largest p which satisfies prefix_sum(p) <= target
+            std::size_t lower_bound(std::size_t target) const {
+                std::size_t p = 0;
+                std::size_t step = 1;
+                while(step * 2 < index.size()) step *= 2;
+                for(; 0 < step; step /= 2) {
+                    if(p + step < index.size() && index[p + step] <= target) {
+                        p += step;
+                        target -= index[p];
+                    }
+                }
+                return p;
+            }
+            
+            TextArena arena;
+            std::uint64_t front_id{0};
+            std::vector<Entry> slots;
+            std::vector<std::size_t> index{0};
+            std::size_t capacity{0};
+            std::size_t head{0};
+            std::size_t count{0};
+            std::size_t total_lines{0};
         };
         
+        // not copyable since entries refer to the text arena and the post() queue is owned by the console.
+        // (it was copyable before them.) move keeps entries valid, arena chunks don't move.
+        BitmapConsole() = default;
+        BitmapConsole(const BitmapConsole &) = delete;
+        BitmapConsole &operator=(const BitmapConsole &) = delete;
+        BitmapConsole(BitmapConsole &&) = default;
+        BitmapConsole &operator=(BitmapConsole &&) = default;
+        
         void setup(Settings settings = Settings()) {
             this->settings = settings;
+            lines.reset(settings.capacity, settings.arena_chunk_size);
+            search_index.clear();
+            filtered_ids.clear();
+            recent_entries.clear();
+            rate_limiters.clear();
+            mesh_cache.is_dirty = true;
+            if(0 < settings.queue_capacity) {
+                queue = std::make_unique<LockFreeQueue<Line>>(settings.queue_capacity);
+            } else {
+                queue.reset();
+            }
+            
+            spool.reset();
+            if(!settings.spool_path.empty()) {
+                const auto path = ofToDataPath(settings.spool_path, true);
+                for(const auto &record : BitmapConsoleSpool::readLast(path, settings.spool_num_replay)) {
+                    push(record.text, record.tag, record.highlighted, record.bg_color, record.fg_color);
+                }
+                spool = std::make_unique<BitmapConsoleSpool>();
+                if(!spool->open(path, settings.spool_max_bytes)) spool.reset();
+            }
+        }
+        
+        // moves lines given by post() into console and finishes rotation of spool.
+        // call from main thread before draw().
+        std::size_t update() {
+            if(spool) spool->update();
+            if(!queue) return 0;
+            std::size_t num_drained = 0;
+            Line line;
+            for(std::size_t n = queue->capacity(); num_drained < n && queue->pop(line); ++num_drained) {
+                add(std::move(line));
+            }
+            return num_drained;
         }
         
         void clear() {
             lines.clear();
+            search_index.clear();
+            filtered_ids.clear();
+            recent_entries.clear();
+            mesh_cache.is_dirty = true;
         }
         
         void add(const std::string &text) {
-            lines.emplace_back(fold(text));
-            calc_max();
+            add_text(text, "", false, ofColor{}, ofColor{}, true);
         }
         
         void add(Line &&line) {
-            lines.emplace_back(fold(line));
-            calc_max();
+            add_text(line.text, line.tag, line.highlighted, line.bg_color, line.fg_color, true);
         }
         void add(const Line &line) {
-            lines.emplace_back(line);
-            calc_max();
+            add_text(line.text, line.tag, line.highlighted, line.bg_color, line.fg_color, false);
         }
         
         void addHighlight(const std::string &text,
                           ofColor background = ofColor::black,
                           ofColor foreground = ofColor::white)
         {
-            lines.emplace_back(fold(text), background, foreground);
-            calc_max();
+            add_text(text, "", true, background, foreground, true);
+        }
+        
+        // post* can be called from any thread. given lines are added on next update().
+        // when queue is full (or setup() is not called yet), the line is dropped.
+        bool post(const std::string &text)
+        { return post(Line{text}); }
+        
+        bool post(Line &&line) {
+            if(!queue) {
+                ofLogWarning("ofxBitmapConsole") << "post() requires setup() with queueCapacity(n) (n > 0). line is dropped.";
+                return false;
+            }
+            return queue->push(std::move(line));
         }
         
+        bool postHighlight(const std::string &text,
+                           ofColor background = ofColor::black,
+                           ofColor foreground = ofColor::white)
+        { return post(Line{text, background, foreground}); }
+        
+        std::uint64_t numDropped() const
+        { return queue ? queue->numDropped() : 0; }
+        
         void draw() const
         { draw(0.0f, 0.0f); }
         
+        // rebuilds cached meshes only when lines, position, window height or color were changed.
         float draw(float x, float y) const {
+            const float height = ofGetHeight();
+            const ofColor &color = ofGetStyle().color;
+            auto &cache = mesh_cache;
+            if(cache.is_dirty || cache.x != x || cache.y != y || cache.height != height || cache.color != color) {
+                cache.bottom = buildMesh(x, y, height, cache.glyphs, cache.backgrounds, color);
+                cache.x = x;
+                cache.y = y;
+                cache.height = height;
+                cache.color = color;
+                cache.is_dirty = false;
+            }
+            
+            ofPushStyle();
+            ofEnableAlphaBlending();
+            if(cache.backgrounds.getNumVertices()) {
+                cache.backgrounds.draw();
+            }
+            if(cache.glyphs.getNumVertices()) {
+                const ofTexture &texture = bitmap_font.getTexture();
+                texture.bind();
+                cache.glyphs.draw();
+                texture.unbind();
+            }
+            ofPopStyle();
+            return cache.bottom;
+        }
+        
+        // builds glyph quads (textured by ofBitmapFont) and highlight backgrounds of visible lines.
+        // doesn't touch GL, so this can be called without GL context.
+        float buildMesh(float x, float y, float height,
+                        ofMesh &glyphs, ofMesh &backgrounds,
+                        const ofColor &color = ofColor::white) const
+        {
+            glyphs.clear();
+            glyphs.setMode(OF_PRIMITIVE_TRIANGLES);
+            backgrounds.clear();
+            backgrounds.setMode(OF_PRIMITIVE_TRIANGLES);
+            
             std::size_t num_line_drawn = 1;
-            if(settings.is_reversed) {
-                for(auto it = lines.rbegin(); it != lines.rend(); ++it) {
-                    const auto &line = *it;
-                    if(ofGetHeight() < y + 20 * num_line_drawn + 20 * line.num_lines) {
-                        break;
-                    }
-                    if(line.highlighted) {
-                        ofDrawBitmapStringHighlight(line.text, x + 20, y + 20 * num_line_drawn, line.bg_color, line.fg_color);
-                    } else {
-                        ofDrawBitmapString(line.text, x + 20, y + 20 * num_line_drawn);
-                    }
-                    num_line_drawn += line.num_lines;
+            auto add_line = [&](const Entry &line) {
+                if(height < y + 20 * num_line_drawn + 20 * line.num_lines) {
+                    return false;
+                }
+                const float line_x = x + 20;
+                const float line_y = y + 20 * num_line_drawn;
+                mesh_text.assign(line.text.data(), line.text.size());
+                if(1 < line.num_repeats) {
+                    mesh_text += " (x" + std::to_string(line.num_repeats) + ")";
+                }
+                if(line.highlighted) {
+                    add_background(backgrounds, mesh_text, line_x, line_y, line.bg_color);
+                    add_glyphs(glyphs, mesh_text, line_x, line_y, line.fg_color);
+                } else {
+                    add_glyphs(glyphs, mesh_text, line_x, line_y, color);
+                }
+                num_line_drawn += line.num_lines;
+                return true;
+            };
+            
+            if(is_filtering()) {
+                // scroll offset is counted by entries
+                const std::size_t num_entries = filtered_ids.size();
+                const std::uint64_t front_id = lines.frontId();
+                for(std::size_t i = std::min(scroll_offset, num_entries); i < num_entries; ++i) {
+                    const auto id = filtered_ids[settings.is_reversed ? num_entries - 1 - i : i];
+                    if(!add_line(lines[id - front_id])) break;
                 }
             } else {
-                for(const auto &line : lines) {
-                    if(ofGetHeight() < y + 20 * num_line_drawn + 20 * line.num_lines) {
-                        break;
-                    }
-                    if(line.highlighted) {
-                        ofDrawBitmapStringHighlight(line.text, x + 20, y + 20 * num_line_drawn, line.bg_color, line.fg_color);
-                    } else {
-                        ofDrawBitmapString(line.text, x + 20, y + 20 * num_line_drawn);
-                    }
-                    num_line_drawn += line.num_lines;
+                const std::size_t num_entries = lines.size();
+                const std::size_t first = firstVisibleEntry();
+                const std::size_t num_visible = (num_entries == 0) ? 0 : settings.is_reversed ? first + 1 : num_entries - first;
+                for(std::size_t i = 0; i < num_visible; ++i) {
+                    if(!add_line(lines[settings.is_reversed ? first - i : first + i])) break;
                 }
             }
             return y + 20 * num_line_drawn;
         }
         
+        std::size_t size() const
+        { return lines.size(); }
+        std::size_t numLines() const
+        { return lines.numLines(); }
+        
+        // n-th entry from the oldest one
+        const Entry &getEntry(std::size_t n) const
+        { return lines[n]; }
+        
+        std::uint64_t numCoalesced() const
+        { return num_coalesced; }
+        std::uint64_t numRateLimited() const
+        { return num_rate_limited; }
+        
+        // nullptr when Settings::spool is not given or failed to open
+        const BitmapConsoleSpool *getSpool() const
+        { return spool.get(); }
+        
+        MemoryFootprint memoryFootprint() const {
+            auto footprint = lines.memoryFootprint();
+            footprint.index += search_index.memoryFootprint() + filtered_ids.size() * sizeof(std::uint64_t);
+            return footprint;
+        }
+        
+        // shows only lines which have given tag (if not empty) and contain substring (if not empty).
+        // matching lines are collected once here (by search index when Settings::searchIndex(true)),
+        // after that, the view is updated incrementally on add / eviction.
+        void setFilter(const Filter &filter) {
+            this->filter = filter;
+            filtered_ids.clear();
+            mesh_cache.is_dirty = true;
+            if(!is_filtering()) return;
+            
+            const std::uint64_t front_id = lines.frontId();
+            const auto *candidates = settings.use_search_index
+                ? search_index.candidates(filter.tag, filter.substring)
+                : nullptr;
+            if(candidates) {
+                for(auto id : *candidates) {
+                    if(filter.matches(lines[id - front_id])) filtered_ids.push_back(id);
+                }
+            } else {
+                for(std::size_t i = 0; i < lines.size(); ++i) {
+                    if(filter.matches(lines[i])) filtered_ids.push_back(front_id + i);
+                }
+            }
+        }
+        void setFilter(const std::string &substring, const std::string &tag = "")
+        { setFilter(Filter{tag, substring}); }
+        void clearFilter()
+        { setFilter(Filter{}); }
+        const Filter &getFilter() const
+        { return filter; }
+        std::size_t numFiltered() const
+        { return is_filtering() ? filtered_ids.size() : lines.size(); }
+        
+        // scroll offset is counted in lines from the oldest line,
+        // or from the newest line when Settings::reverse(true).
+        void scrollTo(std::size_t line_offset) {
+            if(scroll_offset == line_offset) return;
+            scroll_offset = line_offset;
+            mesh_cache.is_dirty = true;
+        }
+        void scrollBy(std::int64_t num_lines) {
+            const std::int64_t offset = static_cast<std::int64_t>(scroll_offset) + num_lines;
+            scrollTo(offset < 0 ? 0 : static_cast<std::size_t>(offset));
+        }
+        void scrollToPixel(float pixel_offset)
+        { scrollTo(pixel_offset < 0.0f ? 0 : static_cast<std::size_t>(pixel_offset / 20)); }
+        std::size_t scrollOffset() const
+        { return scroll_offset; }
+        
+        // index of the first drawn entry (from the oldest). O(log n)
+        std::size_t firstVisibleEntry() const {
+            const std::size_t num_lines = lines.numLines();
+            if(num_lines == 0) return 0;
+            const std::size_t offset = std::min(scroll_offset, num_lines - 1);
+            return lines.findEntry(settings.is_reversed ? num_lines - 1 - offset : offset);
+        }
+        
+        // formats into inline buffer and adds the text to console on destruction.
+        // numbers are formatted by std::to_chars with same result as std::ostream's default.
+        // types which are not string / number are formatted by std::ostringstream.
         struct quasi_ostream {
+            static constexpr std::size_t inline_capacity = 256;
+            
             quasi_ostream() = delete;
             quasi_ostream(const quasi_ostream &mom)
             : console{mom.console}
             , line{mom.line}
-            , os{mom.os.str()}
-            {};
-            quasi_ostream(quasi_ostream &&) = default;
-            quasi_ostream(BitmapConsole &console, Line &&line)
+            , is_posted{mom.is_posted}
+            , overflow{mom.overflow}
+            , size{mom.size}
+            { std::copy(mom.buffer, mom.buffer + mom.size, buffer); };
+            quasi_ostream(quasi_ostream &&mom)
+            : quasi_ostream{static_cast<const quasi_ostream &>(mom)}
+            { mom.is_active = false; };
+            quasi_ostream(BitmapConsole &console, Line &&line, bool is_posted = false)
             : console{console}
             , line{std::move(line)}
-            {};
+            , is_posted{is_posted}
+            {
+                *this << this->line.text;
+                this->line.text.clear();
+            };
             
             ~quasi_ostream() {
-                line.text = os.str();
-                console.add(std::move(line));
+                if(!is_active) return;
+                if(is_posted) {
+                    line.text.assign(text());
+                    line.num_lines = Line::count_lines(line.text);
+                    console.post(std::move(line));
+                } else {
+                    console.add_text(text(), line.tag, line.highlighted, line.bg_color, line.fg_color, true);
+                }
             };
             
             template <typename value_type>
             quasi_ostream &operator<<(const value_type &v) {
-                os << v;
+                using type = typename std::decay<value_type>::type;
+                if constexpr(std::is_same<type, bool>::value) {
+                    append(v ? "1" : "0");
+                } else if constexpr(std::is_same<type, char>::value
+                                    || std::is_same<type, signed char>::value
+                                    || std::is_same<type, unsigned char>::value)
+                {
+                    const char c = static_cast<char>(v);
+                    append(std::string_view{&c, 1});
+                } else if constexpr(std::is_arithmetic<type>::value) {
+                    append_number(v);
+                } else if constexpr(std::is_same<value_type, const char *>::value
+                                    || std::is_same<value_type, char *>::value)
+                {
+                    if(v) append(std::string_view{v});
+                } else if constexpr(std::is_convertible<const value_type &, std::string_view>::value) {
+                    append(std::string_view{v});
+                } else {
+                    std::ostringstream os;
+                    os << v;
+                    append(os.str());
+                }
                 return *this;
             }
             
+            std::string_view text() const {
+                return overflow.empty()
+                    ? std::string_view{buffer, size}
+                    : std::string_view{overflow};
+            }
+            
             BitmapConsole &console;
             Line line;
-            std::ostringstream os{""};
+            bool is_posted{false};
+            
+        protected:
+            void append(std::string_view str) {
+                if(overflow.empty() && size + str.size() <= inline_capacity) {
+                    std::copy(str.begin(), str.end(), buffer + size);
+                    size += str.size();
+                    return;
+                }
+                if(overflow.empty()) overflow.assign(buffer, size);
+                overflow.append(str.data(), str.size());
+            }
+            
+            template <typename number_type>
+            void append_number(number_type v) {
+                char str[64];
+#if defined(__cpp_lib_to_chars)
+                std::to_chars_result result;
+                if constexpr(std::is_floating_point<number_type>::value) {
+                    result = std::to_chars(str, str + sizeof(str), v, std::chars_format::general, 6);
+                } else {
+                    result = std::to_chars(str, str + sizeof(str), v);
+                }
+                append(std::string_view{str, static_cast<std::size_t>(result.ptr - str)});
+#else
+                int length;
+                if constexpr(std::is_floating_point<number_type>::value) {
+                    length = std::snprintf(str, sizeof(str), "%.6Lg", static_cast<long double>(v));
+                } else if constexpr(std::is_signed<number_type>::value) {
+                    length = std::snprintf(str, sizeof(str), "%lld", static_cast<long long>(v));
+                } else {
+                    length = std::snprintf(str, sizeof(str), "%llu", static_cast<unsigned long long>(v));
+                }
+                if(0 < length) append(std::string_view{str, static_cast<std::size_t>(length)});
+#endif
+            }
+            
+            std::string overflow;
+            std::size_t size{0};
+            bool is_active{true};
+            char buffer[inline_capacity];
         };
         
+        quasi_ostream tagged(const std::string &tag) {
+            Line line{""};
+            line.tag = tag;
+            return quasi_ostream{*this, std::move(line)};
+        }
+        
         quasi_ostream highligted(ofColor bg_color = ofColor::black,
                                  ofColor fg_color = ofColor::white)
         {
             return quasi_ostream{*this, Line{"", bg_color, fg_color}};
         }
         
+        // thread safe version of operator<< / highligted
+        quasi_ostream post()
+        { return quasi_ostream{*this, Line{""}, true}; }
+        
+        quasi_ostream postHighlighted(ofColor bg_color = ofColor::black,
+                                      ofColor fg_color = ofColor::white)
+        { return quasi_ostream{*this, Line{"", bg_color, fg_color}, true}; }
+        
         using ostream_manip_t = std::ostream &(*)(std::ostream &);
         BitmapConsole &operator<<(ostream_manip_t manip) {
             if(manip == static_cast<ostream_manip_t>(std::endl)) {
@@ -184,87 +955,283 @@ namespace ofx {
             return *this;
         }
 
-        quasi_ostream operator<<(const std::string &text)
-        { return quasi_ostream{*this, Line{""}} << text; }
+        quasi_ostream operator<<(const std::string &text) {
+            quasi_ostream os{*this, Line{}};
+            os << text;
+            return os;
+        }
+        
+        quasi_ostream operator<<(const char *text) {
+            quasi_ostream os{*this, Line{}};
+            os << text;
+            return os;
+        }
         
     protected:
-        std::vector<Line> lines{};
+        LineStorage lines{};
         Settings settings{};
+        
+        struct MeshCache {
+            ofMesh glyphs;
+            ofMesh backgrounds;
+            float x{0.0f};
+            float y{0.0f};
+            float height{0.0f};
+            ofColor color{};
+            float bottom{0.0f};
+            bool is_dirty{true};
+        };
+        mutable MeshCache mesh_cache;
+        mutable std::string mesh_text;
+        std::size_t scroll_offset{0};
+        ofBitmapFont bitmap_font;
+        std::unique_ptr<LockFreeQueue<Line>> queue;
+        std::unique_ptr<BitmapConsoleSpool> spool;
+        SearchIndex search_index;
+        Filter filter;
+        std::deque<std::uint64_t> filtered_ids;
+        
+        bool is_filtering() const
+        { return !filter.empty(); }
 
-        // basically, generated by ChatGPT o3-mini-high
-        std::string fold(const std::string &input) {
-            if(settings.num_fold == 0) return input;
-            std::regex r("\\s+");
-            std::sregex_token_iterator it(input.begin(), input.end(), r, -1);
-            std::sregex_token_iterator end;
-            std::vector<std::string> words;
-            for(; it != end; ++it) {
-                if(it->str() != "") words.push_back(it->str());
-            }
-            
-            std::vector<std::string> lines;
-            std::string current;
-            for(std::size_t i = 0; i < words.size(); ++i){
-                std::string word = words[i];
-                if(current == "") {
-                    if(word.size() <= settings.num_fold){
-                        current = word;
-                    }
-                    else {
-                        for(std::size_t j = 0; j < word.size(); j += settings.num_fold) {
-                            lines.push_back(word.substr(j, settings.num_fold));
-                        }
-                        current = "";
+        std::string fold_buffer;
+        
+        static bool is_space(char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+        }
+        
+        static bool is_folded_punctuation(char c)
+        { return c == '.' || c == ',' || c == '-'; }
+        
+        // splits input by whitespaces and packs words greedily into lines of num_fold chars.
+        // words longer than num_fold are chopped. leading '.', ',' or '-' of a folded line
+        // is moved to the end of the previous line.
+        static void fold(std::string_view input, std::size_t num_fold, std::string &output) {
+            output.clear();
+            output.reserve(input.size() + input.size() / num_fold + 1);
+            bool is_first_line = true;
+            std::size_t current_length = 0; // 0 means there is no line to append words
+            
+            auto begin_line = [&](std::string_view text) {
+                if(!is_first_line) {
+                    if(is_folded_punctuation(text.front())) {
+                        output += text.front();
+                        text.remove_prefix(1);
                     }
+                    output += '\n';
+                }
+                is_first_line = false;
+                output.append(text.data(), text.size());
+            };
+            auto begin_word = [&](std::string_view word) {
+                if(word.size() <= num_fold) {
+                    begin_line(word);
+                    current_length = word.size();
                 } else {
-                    std::string candidate = current + " " + word;
-                    if(candidate.size() <= settings.num_fold) {
-                        current = candidate;
-                    } else {
-                        lines.push_back(current);
-                        if(word.size() <= settings.num_fold) {
-                            current = word;
-                        } else {
-                            for(std::size_t j = 0; j < word.size(); j += settings.num_fold) {
-                                lines.push_back(word.substr(j, settings.num_fold));
-                            }
-                            current = "";
-                        }
+                    for(std::size_t j = 0; j < word.size(); j += num_fold) {
+                        begin_line(word.substr(j, num_fold));
                     }
+                    current_length = 0;
+                }
+            };
+            
+            std::size_t i = 0;
+            while(i < input.size()) {
+                while(i < input.size() && is_space(input[i])) ++i;
+                if(i == input.size()) break;
+                std::size_t word_begin = i;
+                while(i < input.size() && !is_space(input[i])) ++i;
+                std::string_view word = input.substr(word_begin, i - word_begin);
+                
+                if(current_length != 0 && current_length + 1 + word.size() <= num_fold) {
+                    output += ' ';
+                    output.append(word.data(), word.size());
+                    current_length += 1 + word.size();
+                } else {
+                    begin_word(word);
                 }
             }
-            if(current != "") lines.push_back(current);
-            for(std::size_t i = 1; i < lines.size(); ++i) {
-                if(!lines[i].empty() && (lines[i][0] == '.' || lines[i][0] == ',' || lines[i][0] == '-')) {
-                    char c = lines[i][0];
-                    lines[i].erase(0, 1);
-                    lines[i - 1] += c;
+        }
+        
+        // returned view is valid until next call
+        std::string_view fold(std::string_view input) {
+            if(settings.num_fold == 0) return input;
+            fold(input, settings.num_fold, fold_buffer);
+            return fold_buffer;
+        }
+
+        std::uint64_t num_coalesced{0};
+        std::uint64_t num_rate_limited{0};
+        struct TokenBucket {
+            float tokens{0.0f};
+            float last_time{0.0f};
+        };
+        std::unordered_map<std::uint64_t, TokenBucket> rate_limiters;
+        std::unordered_map<std::uint64_t, std::uint64_t> recent_entries; // hash -> id
+        
+        static std::uint64_t line_hash(std::string_view text,
+                                       std::string_view tag,
+                                       bool highlighted,
+                                       const ofColor &bg_color,
+                                       const ofColor &fg_color)
+        {
+            const unsigned char attributes[] = {
+                static_cast<unsigned char>(highlighted),
+                bg_color.r, bg_color.g, bg_color.b, bg_color.a,
+                fg_color.r, fg_color.g, fg_color.b, fg_color.a,
+            };
+            auto h = fnv1a(tag);
+            h = fnv1a({reinterpret_cast<const char *>(attributes), sizeof(attributes)}, h);
+            return fnv1a(text, h);
+        }
+        
+        // hash can collide, so coalescing compares stored entry too
+        static bool is_same_line(const Entry &entry,
+                                 std::string_view stored_text,
+                                 std::string_view tag,
+                                 bool highlighted,
+                                 const ofColor &bg_color,
+                                 const ofColor &fg_color)
+        {
+            return entry.text == stored_text
+                && entry.tag == tag
+                && entry.highlighted == highlighted
+                && entry.bg_color == bg_color
+                && entry.fg_color == fg_color;
+        }
+        
+        // coalescing and rate limit are applied before folding, so dropped lines cost one hash
+        // (and one comparison with the repeated entry).
+        void add_text(std::string_view text,
+                      std::string_view tag,
+                      bool highlighted,
+                      const ofColor &bg_color,
+                      const ofColor &fg_color,
+                      bool needs_fold)
+        {
+            std::uint64_t hash = 0;
+            if(0 < settings.coalesce_window) {
+                hash = line_hash(text, tag, highlighted, bg_color, fg_color);
+                auto it = recent_entries.find(hash);
+                const std::uint64_t end_id = lines.frontId() + lines.size();
+                if(it != recent_entries.end()
+                   && end_id <= it->second + settings.coalesce_window
+                   && is_same_line(lines[it->second - lines.frontId()], needs_fold ? fold(text) : text,
+                                   tag, highlighted, bg_color, fg_color))
+                {
+                    auto &entry = lines[it->second - lines.frontId()];
+                    ++entry.num_repeats;
+                    entry.last_seen = Clock::shared().getElapsedTimef();
+                    ++num_coalesced;
+                    mesh_cache.is_dirty = true;
+                    return;
+                }
+            }
+            if(0.0f < settings.rate_limit) {
+                const float now = Clock::shared().getElapsedTimef();
+                auto result = rate_limiters.emplace(fnv1a(tag), TokenBucket{settings.rate_limit_burst, now});
+                auto &bucket = result.first->second;
+                bucket.tokens = std::min(settings.rate_limit_burst,
+                                         bucket.tokens + (now - bucket.last_time) * settings.rate_limit);
+                bucket.last_time = now;
+                if(bucket.tokens < 1.0f) {
+                    ++num_rate_limited;
+                    return;
                 }
+                bucket.tokens -= 1.0f;
+            }
+            push(needs_fold ? fold(text) : text, tag, highlighted, bg_color, fg_color);
+            if(0 < settings.coalesce_window && !lines.empty()) {
+                const std::uint64_t id = lines.frontId() + lines.size() - 1;
+                auto &entry = lines[lines.size() - 1];
+                entry.hash = hash;
+                entry.last_seen = Clock::shared().getElapsedTimef();
+                recent_entries[hash] = id;
             }
+        }
+        
+        void push(std::string_view text,
+                  std::string_view tag,
+                  bool highlighted,
+                  const ofColor &bg_color,
+                  const ofColor &fg_color)
+        {
+            if(lines.full()) evict_front();
+            lines.push_back(text, tag, highlighted, bg_color, fg_color);
+            const auto &entry = lines.back();
+            const std::uint64_t id = lines.frontId() + lines.size() - 1;
+            if(settings.use_search_index) search_index.add(id, entry.tag, entry.text);
+            if(is_filtering() && filter.matches(entry)) filtered_ids.push_back(id);
+            if(spool) spool->append(text, tag, highlighted, bg_color, fg_color);
+            calc_max();
+            mesh_cache.is_dirty = true;
+        }
+        
+        void add_glyphs(ofMesh &glyphs,
+                        const std::string &text,
+                        float x, float y,
+                        const ofFloatColor &color) const
+        {
+            const ofMesh &mesh = bitmap_font.getMesh(text, x, y, OF_BITMAPMODE_SIMPLE, true);
+            glyphs.addVertices(mesh.getVertices());
+            glyphs.addTexCoords(mesh.getTexCoords());
+            glyphs.getColors().resize(glyphs.getNumVertices(), color);
+        }
+        
+        // same geometry as ofDrawBitmapStringHighlight
+        static void add_background(ofMesh &backgrounds,
+                                   std::string_view text,
+                                   float x, float y,
+                                   const ofFloatColor &color)
+        {
+            constexpr int padding = 4;
+            constexpr int font_size = 8;
+            constexpr float leading = 1.7f;
             
-            std::string result;
-            for(std::size_t i = 0; i < lines.size(); ++i) {
-                result += lines[i];
-                if(i < lines.size() - 1) result += "\n";
+            int max_line_length = 0;
+            int current_line_length = 0;
+            int num_lines = 1;
+            for(char c : text) {
+                if(c == '\n') {
+                    ++num_lines;
+                    current_line_length = 0;
+                    continue;
+                }
+                current_line_length += (c == '\t') ? 8 - (current_line_length % 8) : 1;
+                max_line_length = std::max(max_line_length, current_line_length);
             }
-            return result;
+            const int height = num_lines * font_size * leading - 1;
+            const int width = max_line_length * font_size;
+            
+            const float left = x - padding;
+            const float top = y - (padding + font_size + 2);
+            const float right = left + width + 2 * padding;
+            const float bottom = top + height + 2 * padding;
+            backgrounds.addVertex({left, top, 0.0f});
+            backgrounds.addVertex({right, top, 0.0f});
+            backgrounds.addVertex({right, bottom, 0.0f});
+            backgrounds.addVertex({left, top, 0.0f});
+            backgrounds.addVertex({right, bottom, 0.0f});
+            backgrounds.addVertex({left, bottom, 0.0f});
+            backgrounds.getColors().resize(backgrounds.getNumVertices(), color);
         }
-
-        Line fold(const Line &line) {
-            Line new_line = line;
-            new_line.text = fold(line.text);
-            new_line.num_lines = Line::count_lines(new_line.text);
-            return new_line;
+        
+        void evict_front() {
+            const auto &entry = lines.front();
+            const std::uint64_t id = lines.frontId();
+            if(settings.use_search_index) search_index.remove(id, entry.tag, entry.text);
+            if(!filtered_ids.empty() && filtered_ids.front() == id) filtered_ids.pop_front();
+            if(0 < settings.coalesce_window) {
+                auto it = recent_entries.find(entry.hash);
+                if(it != recent_entries.end() && it->second == id) recent_entries.erase(it);
+            }
+            lines.pop_front();
         }
-
+        
         void calc_max() {
             if(settings.max_lines == 0) return;
-            auto num_lines = std::accumulate(lines.begin(), lines.end(), 0, [](std::size_t sum, const Line &line) {
-                return sum + line.num_lines;
-            });
-            while(!lines.empty() && settings.max_lines < num_lines) {
-                num_lines -= lines.front().num_lines;
-                lines.erase(lines.begin());
+            while(!lines.empty() && settings.max_lines < lines.numLines()) {
+                evict_front();
             }
         }
     };
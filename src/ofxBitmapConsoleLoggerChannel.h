@@ -0,0 +1,141 @@
+//
+//  ofxBitmapConsoleLoggerChannel.h
+//
+//  Created by 2bit on 2025/03/14.
+//
+
+#ifndef ofxBitmapConsoleLoggerChannel_h
+#define ofxBitmapConsoleLoggerChannel_h
+
+#include "ofLog.h"
+#include "ofUtils.h"
+
+#include "ofxBitmapConsole.h"
+#include "ofxLockFreeQueue.h"
+
+#include <array>
+#include <atomic>
+#include <cstdarg>
+#include <memory>
+#include <string>
+
+namespace ofx {
+    // ofLog* -> bounded lock-free queue -> BitmapConsole (on main thread).
+    // log() only formats the record and pushes it, so it never blocks the calling thread.
+    //
+    //     auto channel = std::make_shared<ofxBitmapConsoleLoggerChannel>();
+    //     channel->setNext(std::make_shared<ofConsoleLoggerChannel>());
+    //     ofSetLoggerChannel(channel);
+    //     ...
+    //     // in ofApp::update()
+    //     channel->drainInto(console);
+    struct BitmapConsoleLoggerChannel : public ofBaseLoggerChannel {
+        static constexpr std::size_t num_levels = OF_LOG_SILENT + 1;
+        
+        struct Record {
+            ofLogLevel level{OF_LOG_NOTICE};
+            std::string module{""};
+            std::string text{""};
+        };
+        
+        struct Style {
+            bool highlighted{false};
+            ofColor bg_color{ofColor::black};
+            ofColor fg_color{ofColor::white};
+        };
+        
+        BitmapConsoleLoggerChannel(std::size_t capacity = 1024)
+        : queue{capacity}
+        {
+            for(auto &counter : num_logged) counter.store(0, std::memory_order_relaxed);
+            for(auto &counter : num_dropped) counter.store(0, std::memory_order_relaxed);
+            styles[OF_LOG_VERBOSE] = Style{true, ofColor::black, ofColor::gray};
+            styles[OF_LOG_WARNING] = Style{true, ofColor::yellow, ofColor::black};
+            styles[OF_LOG_ERROR] = Style{true, ofColor::red, ofColor::white};
+            styles[OF_LOG_FATAL_ERROR] = Style{true, ofColor::magenta, ofColor::white};
+        }
+        
+        virtual ~BitmapConsoleLoggerChannel() = default;
+        
+        // records are also given to next channel (e.g. ofConsoleLoggerChannel).
+        // set before passing this channel to ofSetLoggerChannel.
+        void setNext(std::shared_ptr<ofBaseLoggerChannel> next)
+        { this->next = next; }
+        
+        void setStyle(ofLogLevel level, const Style &style)
+        { styles[level] = style; }
+        
+        void setStyle(ofLogLevel level, ofColor bg_color, ofColor fg_color)
+        { setStyle(level, Style{true, bg_color, fg_color}); }
+        
+        void log(ofLogLevel level, const std::string &module, const std::string &message) override {
+            if(next) next->log(level, module, message);
+            if(num_levels <= static_cast<std::size_t>(level)) return;
+            num_logged[level].fetch_add(1, std::memory_order_relaxed);
+            
+            Record record;
+            record.level = level;
+            record.module = module;
+            record.text.reserve(module.size() + message.size() + 16);
+            record.text += "[";
+            record.text += ofGetLogLevelName(level, true);
+            record.text += "] ";
+            if(!module.empty()) {
+                record.text += module;
+                record.text += ": ";
+            }
+            record.text += message;
+            if(!queue.push(std::move(record))) {
+                num_dropped[level].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        
+        void log(ofLogLevel level, const std::string &module, const char *format, ...) override {
+            va_list args;
+            va_start(args, format);
+            log(level, module, format, args);
+            va_end(args);
+        }
+        
+        void log(ofLogLevel level, const std::string &module, const char *format, va_list args) override {
+            log(level, module, ofVAArgsToString(format, args));
+        }
+        
+        // call from main thread. returns number of records moved into console.
+        std::size_t drainInto(BitmapConsole &console) {
+            std::size_t num_drained = 0;
+            Record record;
+            for(std::size_t n = queue.capacity(); num_drained < n && queue.pop(record); ++num_drained) {
+                const auto &style = styles[record.level];
+                BitmapConsole::Line line{record.text, style.bg_color, style.fg_color};
+                line.highlighted = style.highlighted;
+                line.tag = std::move(record.module);
+                console.add(std::move(line));
+            }
+            return num_drained;
+        }
+        
+        std::uint64_t numLogged(ofLogLevel level) const
+        { return static_cast<std::size_t>(level) < num_levels ? num_logged[level].load(std::memory_order_relaxed) : 0; }
+        
+        // records dropped because the queue was full
+        std::uint64_t numDropped(ofLogLevel level) const
+        { return static_cast<std::size_t>(level) < num_levels ? num_dropped[level].load(std::memory_order_relaxed) : 0; }
+        std::uint64_t numDropped() const
+        { return queue.numDropped(); }
+        
+        std::size_t numPending() const
+        { return queue.size(); }
+    
+    protected:
+        LockFreeQueue<Record> queue;
+        std::array<std::atomic<std::uint64_t>, num_levels> num_logged;
+        std::array<std::atomic<std::uint64_t>, num_levels> num_dropped;
+        std::array<Style, num_levels> styles;
+        std::shared_ptr<ofBaseLoggerChannel> next;
+    };
+}; // namespace ofx
+
+using ofxBitmapConsoleLoggerChannel = ofx::BitmapConsoleLoggerChannel;
+
+#endif /* ofxBitmapConsoleLoggerChannel_h */
@@ -0,0 +1,314 @@
+//
+//  ofxBitmapConsoleSpool.cpp
+//
+//  Created by 2bit on 2025/03/12.
+//
+
+#include "ofxBitmapConsoleSpool.h"
+
+#include "ofLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+
+// spool maps files with mmap. Windows has no implementation which is tested,
+// so building this file fails there unless the spool is disabled explicitly
+// (then open() always fails and BitmapConsole runs without spool).
+#if defined(_WIN32) && !defined(OFX_BITMAP_CONSOLE_NO_SPOOL)
+#   error "ofxBitmapConsoleSpool supports POSIX only. define OFX_BITMAP_CONSOLE_NO_SPOOL to build without spool on Windows."
+#endif
+
+#if !defined(OFX_BITMAP_CONSOLE_NO_SPOOL)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace ofx {
+    namespace {
+        constexpr char spool_magic[8] = {'o', 'f', 'x', 'B', 'C', 'S', 'P', '2'};
+        
+        // file layout:
+        //   [file_header (64 bytes)][record_header][tag][text] (padded to 8)[record_header]...
+        // record_header::size is written last and 0 means end of records.
+        struct file_header {
+            char magic[8];
+            std::uint64_t capacity;
+            std::uint64_t write_offset;
+            unsigned char reserved[40];
+        };
+        static_assert(sizeof(file_header) == 64, "file_header must be 64 bytes");
+        
+        struct record_header {
+            std::uint32_t size; // size of whole record including padding
+            std::uint32_t text_length;
+            std::uint32_t flags;
+            std::uint8_t bg[4];
+            std::uint8_t fg[4];
+            std::uint32_t tag_length;
+        };
+        static_assert(sizeof(record_header) == 24, "record_header must be 24 bytes");
+        
+        constexpr std::size_t data_begin = sizeof(file_header);
+        
+        std::size_t record_size(std::size_t contents_length)
+        { return sizeof(record_header) + ((contents_length + 7) & ~std::size_t{7}); }
+        
+        // returns end offset of valid records
+        template <typename callback_type>
+        std::size_t scan_records(const unsigned char *data,
+                                 std::size_t size,
+                                 callback_type callback)
+        {
+            std::size_t offset = data_begin;
+            while(offset + sizeof(record_header) <= size) {
+                record_header header;
+                std::memcpy(&header, data + offset, sizeof(header));
+                if(header.size == 0
+                   || header.size != record_size(std::size_t{header.tag_length} + header.text_length)
+                   || size < offset + header.size)
+                {
+                    break;
+                }
+                callback(header, reinterpret_cast<const char *>(data + offset + sizeof(record_header)));
+                offset += header.size;
+            }
+            return offset;
+        }
+        
+        bool is_valid_header(const unsigned char *data, std::size_t size) {
+            return data_begin <= size
+                && std::memcmp(data, spool_magic, sizeof(spool_magic)) == 0;
+        }
+        
+        std::vector<unsigned char> read_file(const std::string &file_path) {
+            std::ifstream ifs(file_path, std::ios::binary);
+            if(!ifs) return {};
+            return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+        }
+        
+        bool has_records(const std::string &file_path) {
+            const auto contents = read_file(file_path);
+            return is_valid_header(contents.data(), contents.size())
+                && data_begin < scan_records(contents.data(), contents.size(), [](const record_header &, const char *) {});
+        }
+    };
+
+    bool BitmapConsoleSpool::open(const std::string &path, std::size_t max_bytes) {
+        close();
+        if(max_bytes < data_begin + record_size(0)) {
+            ofLogError("ofxBitmapConsoleSpool") << "max_bytes is too small: " << max_bytes;
+            return false;
+        }
+        this->path = path;
+        this->max_bytes = max_bytes;
+        // previous run stopped between switching to next file and renaming
+        if(has_records(path + ".next")) rename_files();
+        if(!map(active, path, true)) return false;
+        update();
+        return true;
+    }
+    
+    void BitmapConsoleSpool::close() {
+        if(!isOpened()) return;
+        flush();
+        unmap(active);
+        unmap(next);
+        if(retired.data) {
+            unmap(retired);
+            rename_files();
+        }
+        std::remove((path + ".next").c_str());
+    }
+    
+    void BitmapConsoleSpool::update() {
+        if(!isOpened()) return;
+        if(retired.data) {
+            unmap(retired);
+            rename_files();
+        }
+        if(!next.data && !map(next, path + ".next", false)) {
+            ofLogWarning("ofxBitmapConsoleSpool") << "can't prepare next file of " << path;
+        }
+    }
+    
+    // path -> path + ".1", path + ".next" -> path
+    void BitmapConsoleSpool::rename_files() {
+        const std::string old_path = path + ".1";
+        const std::string next_path = path + ".next";
+        std::remove(old_path.c_str());
+        if(std::rename(path.c_str(), old_path.c_str()) != 0) {
+            ofLogWarning("ofxBitmapConsoleSpool") << "can't rename " << path << " to " << old_path;
+        }
+        if(std::rename(next_path.c_str(), path.c_str()) != 0) {
+            ofLogWarning("ofxBitmapConsoleSpool") << "can't rename " << next_path << " to " << path;
+        }
+    }
+    
+    // writes file header into newly mapped data, or continues records of reusable file
+    void BitmapConsoleSpool::prepare_contents(Segment &segment, bool is_reusable) {
+        auto header = reinterpret_cast<file_header *>(segment.data);
+        if(is_reusable && is_valid_header(segment.data, max_bytes) && header->capacity == max_bytes) {
+            // continue after the last complete record. (previous run may crash while writing)
+            auto end = scan_records(segment.data, max_bytes, [](const record_header &, const char *) {});
+            std::memset(segment.data + end, 0, std::min(sizeof(record_header), max_bytes - end));
+            header->write_offset = end;
+        } else {
+            std::memset(segment.data, 0, data_begin + sizeof(record_header));
+            std::memcpy(header->magic, spool_magic, sizeof(spool_magic));
+            header->capacity = max_bytes;
+            header->write_offset = data_begin;
+        }
+    }
+
+#if !defined(OFX_BITMAP_CONSOLE_NO_SPOOL)
+    bool BitmapConsoleSpool::map(Segment &segment, const std::string &file_path, bool keep_contents) {
+        segment.fd = ::open(file_path.c_str(), O_RDWR | O_CREAT, 0644);
+        if(segment.fd < 0) {
+            ofLogError("ofxBitmapConsoleSpool") << "can't open " << file_path;
+            return false;
+        }
+        struct stat st;
+        bool is_reusable = keep_contents
+            && ::fstat(segment.fd, &st) == 0
+            && static_cast<std::size_t>(st.st_size) == max_bytes;
+        if(!is_reusable && ::ftruncate(segment.fd, 0) != 0) {
+            ofLogError("ofxBitmapConsoleSpool") << "can't truncate " << file_path;
+            unmap(segment);
+            return false;
+        }
+        if(::ftruncate(segment.fd, max_bytes) != 0) {
+            ofLogError("ofxBitmapConsoleSpool") << "can't resize " << file_path << " to " << max_bytes << " bytes";
+            unmap(segment);
+            return false;
+        }
+        void *ptr = ::mmap(nullptr, max_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+        if(ptr == MAP_FAILED) {
+            ofLogError("ofxBitmapConsoleSpool") << "can't map " << file_path;
+            unmap(segment);
+            return false;
+        }
+        segment.data = static_cast<unsigned char *>(ptr);
+        prepare_contents(segment, is_reusable);
+        return true;
+    }
+    
+    void BitmapConsoleSpool::unmap(Segment &segment) {
+        if(segment.data) ::munmap(segment.data, max_bytes);
+        segment.data = nullptr;
+        if(0 <= segment.fd) ::close(segment.fd);
+        segment.fd = -1;
+    }
+    
+    void BitmapConsoleSpool::flush() {
+        if(active.data) ::msync(active.data, max_bytes, MS_ASYNC);
+    }
+#else
+    bool BitmapConsoleSpool::map(Segment &, const std::string &file_path, bool) {
+        ofLogError("ofxBitmapConsoleSpool") << "spool is disabled by OFX_BITMAP_CONSOLE_NO_SPOOL. can't open " << file_path;
+        return false;
+    }
+    
+    void BitmapConsoleSpool::unmap(Segment &segment) {
+        segment.data = nullptr;
+        segment.fd = -1;
+    }
+    
+    void BitmapConsoleSpool::flush() {}
+#endif
+
+    std::uint64_t &BitmapConsoleSpool::write_offset() const
+    { return reinterpret_cast<file_header *>(active.data)->write_offset; }
+    
+    std::size_t BitmapConsoleSpool::bytesUsed() const
+    { return isOpened() ? write_offset() : 0; }
+    
+    bool BitmapConsoleSpool::append(std::string_view text,
+                                    std::string_view tag,
+                                    bool highlighted,
+                                    const ofColor &bg_color,
+                                    const ofColor &fg_color)
+    {
+        if(!isOpened()) return false;
+        const std::size_t size = record_size(tag.size() + text.size());
+        if(max_bytes < data_begin + size) {
+            ++num_dropped;
+            return false;
+        }
+        
+        if(max_bytes < write_offset() + size) {
+            if(!next.data) {
+                // previous rotation is not finished by update() yet
+                update();
+                ++num_sync_rotations;
+                if(!next.data) {
+                    ++num_dropped;
+                    return false;
+                }
+            }
+            retired = active;
+            active = next;
+            next = Segment{};
+            ++num_rotations;
+        }
+        const std::uint64_t offset = write_offset();
+        
+        record_header header;
+        header.size = 0;
+        header.text_length = static_cast<std::uint32_t>(text.size());
+        header.flags = highlighted ? 1 : 0;
+        header.bg[0] = bg_color.r;
+        header.bg[1] = bg_color.g;
+        header.bg[2] = bg_color.b;
+        header.bg[3] = bg_color.a;
+        header.fg[0] = fg_color.r;
+        header.fg[1] = fg_color.g;
+        header.fg[2] = fg_color.b;
+        header.fg[3] = fg_color.a;
+        header.tag_length = static_cast<std::uint32_t>(tag.size());
+        
+        unsigned char *dst = active.data + offset;
+        std::memcpy(dst, &header, sizeof(header));
+        std::memcpy(dst + sizeof(header), tag.data(), tag.size());
+        std::memcpy(dst + sizeof(header) + tag.size(), text.data(), text.size());
+        if(offset + size + sizeof(record_header) <= max_bytes) {
+            // terminates records for the reader. (there may be garbage of the record broken by crash)
+            std::memset(dst + size, 0, sizeof(record_header));
+        }
+        // size is written last, so reader of the mapped file never sees incomplete record
+        std::atomic_thread_fence(std::memory_order_release);
+        const std::uint32_t committed_size = static_cast<std::uint32_t>(size);
+        std::memcpy(dst, &committed_size, sizeof(committed_size));
+        write_offset() = offset + size;
+        ++num_appended;
+        return true;
+    }
+    
+    std::vector<BitmapConsoleSpool::Record> BitmapConsoleSpool::readLast(const std::string &path,
+                                                                         std::size_t num_records)
+    {
+        std::deque<Record> records;
+        if(num_records == 0) return {};
+        for(const auto &file_path : { path + ".1", path, path + ".next" }) {
+            const auto contents = read_file(file_path);
+            if(!is_valid_header(contents.data(), contents.size())) continue;
+            scan_records(contents.data(), contents.size(), [&](const record_header &header, const char *record_data) {
+                Record record;
+                record.tag.assign(record_data, header.tag_length);
+                record.text.assign(record_data + header.tag_length, header.text_length);
+                record.highlighted = header.flags & 1;
+                record.bg_color.set(header.bg[0], header.bg[1], header.bg[2], header.bg[3]);
+                record.fg_color.set(header.fg[0], header.fg[1], header.fg[2], header.fg[3]);
+                records.push_back(std::move(record));
+                if(num_records < records.size()) records.pop_front();
+            });
+        }
+        return {std::make_move_iterator(records.begin()), std::make_move_iterator(records.end())};
+    }
+}; // namespace ofx
@@ -0,0 +1,98 @@
+//
+//  ofxBitmapConsoleSpool.h
+//
+//  Created by 2bit on 2025/03/12.
+//
+
+#ifndef ofxBitmapConsoleSpool_h
+#define ofxBitmapConsoleSpool_h
+
+#include "ofColor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ofx {
+    // memory mapped, size capped log file for BitmapConsole. POSIX only (mmap), see ofxBitmapConsoleSpool.cpp.
+    // when the file is full, append() switches to next file which is mapped in advance (path + ".next"),
+    // and update() renames the full file to path + ".1", the next file to path and maps new next file.
+    // so append() is memcpy except when the next file is not ready yet (i.e. two rotations between update()).
+    // single writer: call append() / update() from the same thread.
+    struct BitmapConsoleSpool {
+        struct Record {
+            std::string text;
+            std::string tag;
+            bool highlighted{false};
+            ofColor bg_color{};
+            ofColor fg_color{};
+        };
+        
+        BitmapConsoleSpool() = default;
+        BitmapConsoleSpool(const BitmapConsoleSpool &) = delete;
+        BitmapConsoleSpool &operator=(const BitmapConsoleSpool &) = delete;
+        ~BitmapConsoleSpool()
+        { close(); }
+        
+        bool open(const std::string &path, std::size_t max_bytes);
+        void close();
+        bool isOpened() const
+        { return active.data != nullptr; }
+        
+        bool append(std::string_view text,
+                    std::string_view tag,
+                    bool highlighted,
+                    const ofColor &bg_color,
+                    const ofColor &fg_color);
+        
+        // finishes rotation started by append() and maps next file. BitmapConsole::update() calls this.
+        void update();
+        
+        // asks OS to write back dirty pages. doesn't wait.
+        void flush();
+        
+        std::uint64_t numAppended() const
+        { return num_appended; }
+        std::uint64_t numDropped() const
+        { return num_dropped; }
+        std::uint64_t numRotations() const
+        { return num_rotations; }
+        // rotations which had to map next file inside append()
+        std::uint64_t numSyncRotations() const
+        { return num_sync_rotations; }
+        bool isNextReady() const
+        { return next.data != nullptr; }
+        std::size_t bytesUsed() const;
+        
+        // reads last num_records records from path + ".1", path and path + ".next".
+        static std::vector<Record> readLast(const std::string &path, std::size_t num_records);
+    
+    protected:
+        struct Segment {
+            unsigned char *data{nullptr};
+            int fd{-1};
+        };
+        
+        bool map(Segment &segment, const std::string &file_path, bool keep_contents);
+        void unmap(Segment &segment);
+        void rename_files();
+        void prepare_contents(Segment &segment, bool is_reusable);
+        std::uint64_t &write_offset() const;
+        
+        std::string path;
+        std::size_t max_bytes{0};
+        Segment active;
+        Segment next;
+        Segment retired; // full file which is not renamed yet
+        std::uint64_t num_appended{0};
+        std::uint64_t num_dropped{0};
+        std::uint64_t num_rotations{0};
+        std::uint64_t num_sync_rotations{0};
+    };
+}; // namespace ofx
+
+using ofxBitmapConsoleSpool = ofx::BitmapConsoleSpool;
+
+#endif /* ofxBitmapConsoleSpool_h */
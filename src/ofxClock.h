@@ -0,0 +1,90 @@
+//
+//  ofxClock.h
+//
+//  Created by 2bit on 2025/03/18.
+//
+
+#ifndef ofxClock_h
+#define ofxClock_h
+
+#include "ofUtils.h"
+
+#include <cstdint>
+
+namespace ofx {
+    // time source shared by CrossFade, VideoFader, CrossFadeScheduler, LimitedLife and BitmapConsole.
+    // realtime mode returns ofGetElapsedTimef().
+    // offline mode returns start_time + frame * time_step and goes forward only by advance(),
+    // so headless export can render faster than realtime and produces same frames every run.
+    //
+    //     ofxClock::shared().setOffline(1.0 / 60.0);
+    //     while(exporting) {
+    //         update(); draw(); save();
+    //         ofxClock::shared().advance();
+    //     }
+    struct Clock {
+        enum class Mode {
+            Realtime,
+            Offline
+        };
+        
+        static Clock &shared() {
+            static Clock clock;
+            return clock;
+        }
+        
+        void setRealtime()
+        { mode = Mode::Realtime; }
+        
+        void setOffline(double time_step, double start_time = 0.0) {
+            mode = Mode::Offline;
+            this->time_step = time_step;
+            this->start_time = start_time;
+            frame = 0;
+        }
+        
+        // offline: goes forward num_frames steps. realtime: does nothing.
+        void advance(std::uint64_t num_frames = 1) {
+            if(mode == Mode::Offline) frame += num_frames;
+        }
+        
+        void setFrame(std::uint64_t frame)
+        { this->frame = frame; }
+        
+        float getElapsedTimef() const
+        { return static_cast<float>(getElapsedTime()); }
+        
+        double getElapsedTime() const {
+            // multiplication instead of accumulation, time doesn't drift with frame count
+            if(mode == Mode::Offline) return start_time + static_cast<double>(frame) * time_step;
+            return ofGetElapsedTimef();
+        }
+        
+        // frame count of offline mode
+        std::uint64_t getFrame() const
+        { return frame; }
+        
+        double getTimeStep() const
+        { return time_step; }
+        
+        bool isOffline() const
+        { return mode == Mode::Offline; }
+        
+        Mode getMode() const
+        { return mode; }
+    
+    protected:
+        Mode mode{Mode::Realtime};
+        double time_step{1.0 / 60.0};
+        double start_time{0.0};
+        std::uint64_t frame{0};
+    };
+    
+    // time of Clock::shared(). can be used as time_func of ofxLimitedLife.
+    inline float getElapsedTimef()
+    { return Clock::shared().getElapsedTimef(); }
+}; // namespace ofx
+
+using ofxClock = ofx::Clock;
+
+#endif /* ofxClock_h */
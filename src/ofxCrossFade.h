@@ -9,24 +9,53 @@
 #include "ofVideoPlayer.h"
 #include "ofUtils.h"
 
+#include "ofxClock.h"
+#include "ofxEasing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <memory>
 
 namespace ofx {
     struct CrossFade : public ofBaseDraws {
         using Ref = std::shared_ptr<CrossFade>;
         
-        static Ref create(const ofBaseDraws &from, const ofBaseDraws &to, float duration)
-        { return std::make_shared<CrossFade>(from, to, duration); }
+        static Ref create(const ofBaseDraws &from,
+                          const ofBaseDraws &to,
+                          float duration,
+                          const Clock &clock = Clock::shared())
+        { return std::make_shared<CrossFade>(from, to, duration, clock); }
         
-        CrossFade(const ofBaseDraws &from, const ofBaseDraws &to, float duration)
+        CrossFade(const ofBaseDraws &from,
+                  const ofBaseDraws &to,
+                  float duration,
+                  const Clock &clock = Clock::shared())
         : duration{duration}
-        , start_time{ofGetElapsedTimef()}
+        , start_time{clock.getElapsedTimef()}
+        , clock{clock}
         , from{from}
         , to{to}
         {}
         
         bool completed() const
-        { return duration + start_time <= ofGetElapsedTimef(); }
+        { return duration + start_time <= clock.getElapsedTimef(); }
+        
+        // time based progress. 0.0 - 1.0
+        float getProgress() const
+        { return 0.0f < duration ? ofClamp((clock.getElapsedTimef() - start_time) / duration, 0.0f, 1.0f) : 1.0f; }
+        
+        // curve applied to progress. default is Ease::Linear
+        void setCurve(const EasingCurve &curve)
+        { this->curve = curve; }
+        const EasingCurve &getCurve() const
+        { return curve; }
+        
+        // curve(progress) clamped to 0.0 - 1.0 (overshooting curves like InBack are clamped).
+        // alpha of `to` is getMix() * 255
+        float getMix() const
+        { return ofClamp(curve(getProgress()), 0.0f, 1.0f); }
         virtual bool update()
         { return completed(); };
         
@@ -38,8 +67,7 @@ namespace ofx {
         
         using ofBaseDraws::draw;
         virtual void draw(float x, float y, float width, float height) const override {
-            auto now = ofGetElapsedTimef();
-            auto alpha = ofMap(now - start_time, 0, duration, 0, 255);
+            auto alpha = getMix() * 255.0f;
             ofSetColor(255, 255, 255);
             from.draw(x, y, width, height);
             ofSetColor(255, 255, 255, alpha);
@@ -51,44 +79,201 @@ namespace ofx {
                 ref.reset();
             }
         }
-
+    
     protected:
         float duration{0.5f};
         float start_time;
+        const Clock &clock;
+        EasingCurve curve;
         
         const ofBaseDraws &from;
         const ofBaseDraws &to;
     };
     
-    struct VideoFader : public CrossFade {
-        using Ref = std::shared_ptr<VideoFader>;
+    // crossfade between two video players.
+    // player_type is ofVideoPlayer or anything drawable which has
+    // update / isFrameNew / isPaused / setPaused / setFrame (e.g. synthetic source for testing).
+    //
+    // phases:
+    //   preroll:   `to` is played and updated but not drawn, so the decoder start up (first frames, texture upload)
+    //              happens while only `from` is visible. fade starts when preroll_frames new frames of `to`
+    //              are decoded or preroll_timeout is passed. off by default.
+    //   fading:    same as CrossFade.
+    //   rewinding: `from` is paused at the end of fade and setFrame(0) is called rewind_delay_frames updates later.
+    //              seek is still synchronous, this only moves it off the frame where the fade ends.
+    //              delay is 0 by default, i.e. rewind in the update() which completes the fade, as before.
+    // update() returns true after rewind. Stats has time spent in update() of each phase.
+    template <typename player_type>
+    struct BasicVideoFader : public CrossFade {
+        using Ref = std::shared_ptr<BasicVideoFader>;
+        
+        enum class Phase {
+            Preroll,
+            Fading,
+            Rewinding,
+            Completed
+        };
         
-        VideoFader(ofVideoPlayer &from, ofVideoPlayer &to, float duration)
-        : CrossFade{from, to, duration}
+        struct Settings {
+            std::size_t preroll_frames{0};
+            float preroll_timeout{0.5f};
+            bool rewind_on_complete{true};
+            std::size_t rewind_delay_frames{0};
+            
+            Settings &preroll(std::size_t num_frames, float timeout = 0.5f) {
+                preroll_frames = num_frames;
+                preroll_timeout = timeout;
+                return *this;
+            }
+            Settings &rewind(bool enabled, std::size_t delay_frames = 0) {
+                rewind_on_complete = enabled;
+                rewind_delay_frames = delay_frames;
+                return *this;
+            }
+        };
+        
+        // hitch: wall time spent in update() (decode, seek)
+        struct Stats {
+            std::size_t num_preroll_frames{0};
+            std::size_t num_preroll_updates{0};
+            float preroll_time{0.0f}; // on clock
+            std::uint64_t preroll_nanos{0}; // sum of update() in preroll
+            std::uint64_t start_hitch_nanos{0}; // first update() of fading
+            std::uint64_t max_fade_update_nanos{0};
+            std::uint64_t rewind_nanos{0}; // setFrame(0) of `from`
+        };
+        
+        static Ref create(player_type &from,
+                          player_type &to,
+                          float duration,
+                          const Settings &settings = Settings{},
+                          const Clock &clock = Clock::shared())
+        { return std::make_shared<BasicVideoFader>(from, to, duration, settings, clock); }
+        
+        BasicVideoFader(player_type &from,
+                        player_type &to,
+                        float duration,
+                        const Settings &settings = Settings{},
+                        const Clock &clock = Clock::shared())
+        : CrossFade{from, to, duration, clock}
         , from{from}
         , to{to}
-        {}
+        , settings{settings}
+        {
+            if(0 < settings.preroll_frames) {
+                phase = Phase::Preroll;
+                preroll_start_time = start_time;
+                // progress is 0 until fading starts
+                start_time = std::numeric_limits<float>::max();
+                if(to.isPaused()) to.setPaused(false);
+            }
+        }
         
         bool update() override {
+            const auto begin = std::chrono::steady_clock::now();
+            const Phase current_phase = phase;
+            switch(phase) {
+                case Phase::Preroll: {
+                    update_players();
+                    ++stats.num_preroll_updates;
+                    const float now = clock.getElapsedTimef();
+                    if(settings.preroll_frames <= stats.num_preroll_frames
+                       || settings.preroll_timeout <= now - preroll_start_time)
+                    {
+                        stats.preroll_time = now - preroll_start_time;
+                        start_time = now;
+                        phase = Phase::Fading;
+                    }
+                    break;
+                }
+                case Phase::Fading:
+                    update_players();
+                    if(completed()) {
+                        from.setPaused(true);
+                        if(!settings.rewind_on_complete) {
+                            phase = Phase::Completed;
+                        } else if(settings.rewind_delay_frames == 0) {
+                            rewind();
+                            phase = Phase::Completed;
+                        } else {
+                            rewind_wait = settings.rewind_delay_frames;
+                            phase = Phase::Rewinding;
+                        }
+                    }
+                    break;
+                case Phase::Rewinding:
+                    update_players();
+                    if(--rewind_wait == 0) {
+                        rewind();
+                        phase = Phase::Completed;
+                    }
+                    break;
+                case Phase::Completed:
+                    break;
+            }
+            const std::uint64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+            if(current_phase == Phase::Preroll) {
+                stats.preroll_nanos += nanos;
+            } else if(current_phase == Phase::Fading) {
+                if(is_first_fading_update) stats.start_hitch_nanos = nanos;
+                is_first_fading_update = false;
+                stats.max_fade_update_nanos = std::max(stats.max_fade_update_nanos, nanos);
+            }
+            return phase == Phase::Completed;
+        }
+        
+        // `to` is not drawn while preroll
+        using ofBaseDraws::draw;
+        void draw(float x, float y, float width, float height) const override {
+            if(phase != Phase::Preroll) {
+                CrossFade::draw(x, y, width, height);
+                return;
+            }
+            ofSetColor(255, 255, 255);
+            from.draw(x, y, width, height);
+        }
+        
+        Phase getPhase() const
+        { return phase; }
+        
+        const Stats &getStats() const
+        { return stats; }
+        
+        player_type &from;
+        player_type &to;
+        
+    protected:
+        void update_players() {
             if(!from.isPaused()) {
                 from.update();
             }
             if(!to.isPaused()) {
                 to.update();
+                if(phase == Phase::Preroll && to.isFrameNew()) ++stats.num_preroll_frames;
             }
-            if(completed()) {
-                from.setPaused(true);
-                from.setFrame(0);
-                return true;
-            }
-            return false;
         }
         
-        ofVideoPlayer &from;
-        ofVideoPlayer &to;
+        void rewind() {
+            const auto begin = std::chrono::steady_clock::now();
+            from.setFrame(0);
+            stats.rewind_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+        }
+        
+        Settings settings;
+        Stats stats;
+        Phase phase{Phase::Fading};
+        float preroll_start_time{0.0f};
+        std::size_t rewind_wait{0};
+        bool is_first_fading_update{true};
     };
+    
+    using VideoFader = BasicVideoFader<ofVideoPlayer>;
 };
 
 using ofxCrossFade = ofx::CrossFade;
+using ofxVideoFader = ofx::VideoFader;
+
+template <typename player_type>
+using ofxBasicVideoFader = ofx::BasicVideoFader<player_type>;
 
 #endif // OFXCROSSFADE_H
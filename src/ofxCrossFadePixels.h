@@ -0,0 +1,243 @@
+//
+//  ofxCrossFadePixels.h
+//
+//  Created by 2bit on 2025/03/17.
+//
+
+#ifndef ofxCrossFadePixels_h
+#define ofxCrossFadePixels_h
+
+#include "ofPixels.h"
+#include "ofLog.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && 2 <= _M_IX86_FP)
+#   include <immintrin.h>
+#   define OFX_CROSSFADE_PIXELS_SSE2 1
+#endif
+
+namespace ofx {
+    // crossfade of two pixels on CPU: dst = from * (1 - alpha) + to * alpha for each channel,
+    // alpha channel included. alpha is mix of fade in 0.0 - 1.0 (e.g. CrossFade::getMix()).
+    // for opaque sources this is same as CrossFade::draw (`to` drawn over `from` with alpha).
+    // for translucent sources it differs, because draw blends with alpha of each pixel too.
+    // kernels use AVX2 / SSE2 when compiler targets them, otherwise plain loop.
+    // rows are split to num_tasks chunks given to dispatch (same as ofxSwitchExecutor::flushParallel).
+    //
+    //     ofxCrossFadePixels::blend(from_pixels, to_pixels, fade->getMix(), dst_pixels, 8, pool_dispatch);
+    //     ofxCrossFadePixels::blend(from_pixels, to_pixels, fade->getMix(), dst_pixels, 4); // spawns threads
+    struct CrossFadePixels {
+        // dispatch(num_tasks, task) must call task(i) for each i in [0, num_tasks) (maybe in parallel)
+        // and return after all calls finished. e.g. wrap thread pool of your app.
+        template <
+            typename dispatch_type,
+            typename = typename std::enable_if<!std::is_integral<typename std::decay<dispatch_type>::type>::value>::type
+        >
+        static bool blend(const ofPixels &from,
+                          const ofPixels &to,
+                          float alpha,
+                          ofPixels &dst,
+                          std::size_t num_tasks,
+                          dispatch_type &&dispatch)
+        {
+            if(!prepare(from, to, dst)) return false;
+            // 8bit fixed point weight (0 - 256)
+            const std::uint32_t weight = static_cast<std::uint32_t>(std::min(std::max(alpha, 0.0f), 1.0f) * 256.0f + 0.5f);
+            run_rows(from, num_tasks, dispatch, [&](std::size_t begin, std::size_t end) {
+                blend_range(from.getData() + begin, to.getData() + begin, dst.getData() + begin, end - begin, weight);
+            });
+            return true;
+        }
+        
+        template <
+            typename dispatch_type,
+            typename = typename std::enable_if<!std::is_integral<typename std::decay<dispatch_type>::type>::value>::type
+        >
+        static bool blend(const ofFloatPixels &from,
+                          const ofFloatPixels &to,
+                          float alpha,
+                          ofFloatPixels &dst,
+                          std::size_t num_tasks,
+                          dispatch_type &&dispatch)
+        {
+            if(!prepare(from, to, dst)) return false;
+            alpha = std::min(std::max(alpha, 0.0f), 1.0f);
+            run_rows(from, num_tasks, dispatch, [&](std::size_t begin, std::size_t end) {
+                blend_range(from.getData() + begin, to.getData() + begin, dst.getData() + begin, end - begin, alpha);
+            });
+            return true;
+        }
+        
+        // spawns num_threads - 1 threads per call. for frequent calls (e.g. every frame), pass dispatch of a thread pool.
+        static bool blend(const ofPixels &from,
+                          const ofPixels &to,
+                          float alpha,
+                          ofPixels &dst,
+                          std::size_t num_threads = 1)
+        { return blend(from, to, alpha, dst, num_threads, [](std::size_t num_tasks, const auto &task) { spawn_threads(num_tasks, task); }); }
+        
+        static bool blend(const ofFloatPixels &from,
+                          const ofFloatPixels &to,
+                          float alpha,
+                          ofFloatPixels &dst,
+                          std::size_t num_threads = 1)
+        { return blend(from, to, alpha, dst, num_threads, [](std::size_t num_tasks, const auto &task) { spawn_threads(num_tasks, task); }); }
+        
+        // name of kernel used by this build
+        static const char *kernelName() {
+#if defined(__AVX2__)
+            return "avx2";
+#elif defined(OFX_CROSSFADE_PIXELS_SSE2)
+            return "sse2";
+#else
+            return "scalar";
+#endif
+        }
+    
+    protected:
+        template <typename pixels_type>
+        static bool prepare(const pixels_type &from, const pixels_type &to, pixels_type &dst) {
+            if(!from.isAllocated() || !to.isAllocated()) {
+                ofLogWarning("ofxCrossFadePixels") << "from or to is not allocated";
+                return false;
+            }
+            if(from.getWidth() != to.getWidth()
+               || from.getHeight() != to.getHeight()
+               || from.getNumChannels() != to.getNumChannels())
+            {
+                ofLogWarning("ofxCrossFadePixels") << "from and to must have same size and number of channels";
+                return false;
+            }
+            if(dst.getWidth() != from.getWidth()
+               || dst.getHeight() != from.getHeight()
+               || dst.getNumChannels() != from.getNumChannels())
+            {
+                dst.allocate(from.getWidth(), from.getHeight(), from.getNumChannels());
+            }
+            return true;
+        }
+        
+        // calls kernel(begin, end) with element ranges of whole rows, split to num_tasks tasks
+        template <typename pixels_type, typename dispatch_type, typename kernel_type>
+        static void run_rows(const pixels_type &pixels, std::size_t num_tasks, dispatch_type &dispatch, kernel_type kernel) {
+            const std::size_t height = pixels.getHeight();
+            const std::size_t row_size = pixels.getWidth() * pixels.getNumChannels();
+            num_tasks = std::max<std::size_t>(1, std::min(num_tasks, height));
+            if(num_tasks == 1) {
+                kernel(0, row_size * height);
+                return;
+            }
+            const std::size_t rows_per_task = (height + num_tasks - 1) / num_tasks;
+            num_tasks = (height + rows_per_task - 1) / rows_per_task;
+            dispatch(num_tasks, [&](std::size_t i) {
+                const std::size_t row = i * rows_per_task;
+                kernel(row * row_size, std::min(row + rows_per_task, height) * row_size);
+            });
+        }
+        
+        // dispatch which runs each task on its own thread (task 0 on calling thread)
+        template <typename task_type>
+        static void spawn_threads(std::size_t num_tasks, const task_type &task) {
+            std::vector<std::thread> threads;
+            threads.reserve(num_tasks - 1);
+            for(std::size_t i = 1; i < num_tasks; ++i) threads.emplace_back([&task, i] { task(i); });
+            task(0);
+            for(auto &thread : threads) thread.join();
+        }
+        
+        // dst = (from * (256 - weight) + to * weight + 128) >> 8
+        static void blend_range(const unsigned char *from,
+                                const unsigned char *to,
+                                unsigned char *dst,
+                                std::size_t size,
+                                std::uint32_t weight)
+        {
+            std::size_t i = 0;
+#if defined(__AVX2__)
+            {
+                const __m256i w_to = _mm256_set1_epi16(static_cast<short>(weight));
+                const __m256i w_from = _mm256_set1_epi16(static_cast<short>(256 - weight));
+                const __m256i round = _mm256_set1_epi16(128);
+                const __m256i zero = _mm256_setzero_si256();
+                for(; i + 32 <= size; i += 32) {
+                    const __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i));
+                    const __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(to + i));
+                    // unpack works in 128bit lanes and packus puts them back in same order
+                    __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(f, zero), w_from),
+                                                  _mm256_mullo_epi16(_mm256_unpacklo_epi8(t, zero), w_to));
+                    __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(f, zero), w_from),
+                                                  _mm256_mullo_epi16(_mm256_unpackhi_epi8(t, zero), w_to));
+                    lo = _mm256_srli_epi16(_mm256_add_epi16(lo, round), 8);
+                    hi = _mm256_srli_epi16(_mm256_add_epi16(hi, round), 8);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_packus_epi16(lo, hi));
+                }
+            }
+#endif
+#if defined(OFX_CROSSFADE_PIXELS_SSE2)
+            {
+                const __m128i w_to = _mm_set1_epi16(static_cast<short>(weight));
+                const __m128i w_from = _mm_set1_epi16(static_cast<short>(256 - weight));
+                const __m128i round = _mm_set1_epi16(128);
+                const __m128i zero = _mm_setzero_si128();
+                for(; i + 16 <= size; i += 16) {
+                    const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+                    const __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i *>(to + i));
+                    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(f, zero), w_from),
+                                               _mm_mullo_epi16(_mm_unpacklo_epi8(t, zero), w_to));
+                    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(f, zero), w_from),
+                                               _mm_mullo_epi16(_mm_unpackhi_epi8(t, zero), w_to));
+                    lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 8);
+                    hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 8);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+                }
+            }
+#endif
+            for(; i < size; ++i) {
+                dst[i] = static_cast<unsigned char>((from[i] * (256 - weight) + to[i] * weight + 128) >> 8);
+            }
+        }
+        
+        // dst = from + (to - from) * alpha
+        static void blend_range(const float *from,
+                                const float *to,
+                                float *dst,
+                                std::size_t size,
+                                float alpha)
+        {
+            std::size_t i = 0;
+#if defined(__AVX2__)
+            {
+                const __m256 a = _mm256_set1_ps(alpha);
+                for(; i + 8 <= size; i += 8) {
+                    const __m256 f = _mm256_loadu_ps(from + i);
+                    const __m256 t = _mm256_loadu_ps(to + i);
+                    _mm256_storeu_ps(dst + i, _mm256_add_ps(f, _mm256_mul_ps(_mm256_sub_ps(t, f), a)));
+                }
+            }
+#endif
+#if defined(OFX_CROSSFADE_PIXELS_SSE2)
+            {
+                const __m128 a = _mm_set1_ps(alpha);
+                for(; i + 4 <= size; i += 4) {
+                    const __m128 f = _mm_loadu_ps(from + i);
+                    const __m128 t = _mm_loadu_ps(to + i);
+                    _mm_storeu_ps(dst + i, _mm_add_ps(f, _mm_mul_ps(_mm_sub_ps(t, f), a)));
+                }
+            }
+#endif
+            for(; i < size; ++i) {
+                dst[i] = from[i] + (to[i] - from[i]) * alpha;
+            }
+        }
+    };
+}; // namespace ofx
+
+using ofxCrossFadePixels = ofx::CrossFadePixels;
+
+#endif /* ofxCrossFadePixels_h */
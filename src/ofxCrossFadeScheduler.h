@@ -0,0 +1,213 @@
+//
+//  ofxCrossFadeScheduler.h
+//
+//  Created by 2bit on 2025/03/16.
+//
+
+#ifndef ofxCrossFadeScheduler_h
+#define ofxCrossFadeScheduler_h
+
+#include "ofGraphics.h"
+#include "ofGraphicsBaseTypes.h"
+#include "ofUtils.h"
+
+#include "ofxClock.h"
+#include "ofxEasing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace ofx {
+    // runs many crossfades in one contiguous pool.
+    // update() reads clock (Clock::shared() or setClock()) once and advances all fades.
+    // completed fades are retired into free list and their slots are reused,
+    // so there is no allocation after the pool has grown to peak size.
+    // fades started in a frame begin at next update(), so fades started together stay in sync.
+    //
+    //     ofxCrossFadeScheduler scheduler;
+    //     scheduler.reserve(512);
+    //     tile.fade = scheduler.start(tile.current, tile.next, 0.5f);
+    //     ...
+    //     scheduler.update();
+    //     for(auto &tile : tiles) scheduler.draw(tile.fade, tile.x, tile.y, tile.w, tile.h);
+    struct CrossFadeScheduler {
+        // index + generation. handle of retired fade becomes invalid even if slot is reused.
+        struct Handle {
+            std::uint32_t index{0};
+            std::uint32_t generation{0};
+            
+            bool operator==(const Handle &x) const
+            { return index == x.index && generation == x.generation; }
+            bool operator!=(const Handle &x) const
+            { return !(*this == x); }
+        };
+        
+        struct Stats {
+            std::size_t num_active{0};
+            std::size_t num_started{0}; // in last update()
+            std::size_t num_completed{0}; // in last update()
+            std::size_t capacity{0};
+            std::uint64_t update_nanos{0}; // cost of last update()
+            std::uint64_t total_updates{0};
+        };
+        
+        void reserve(std::size_t capacity) {
+            slots.reserve(capacity);
+            active.reserve(capacity);
+            free_slots.reserve(capacity);
+            completed.reserve(capacity);
+        }
+        
+        Handle start(const ofBaseDraws &from,
+                     const ofBaseDraws &to,
+                     float duration,
+                     const EasingCurve &curve = EasingCurve{})
+        {
+            std::uint32_t index;
+            if(free_slots.empty()) {
+                index = static_cast<std::uint32_t>(slots.size());
+                slots.emplace_back();
+            } else {
+                index = free_slots.back();
+                free_slots.pop_back();
+            }
+            Slot &slot = slots[index];
+            slot.from = &from;
+            slot.to = &to;
+            slot.duration = duration;
+            slot.start_time = 0.0f;
+            slot.progress = 0.0f;
+            slot.mix = 0.0f;
+            slot.curve = curve;
+            slot.is_pending = true;
+            slot.active_position = static_cast<std::uint32_t>(active.size());
+            active.push_back(index);
+            return Handle{index, slot.generation};
+        }
+        
+        // retires fade without completing it
+        void cancel(Handle handle) {
+            if(!isActive(handle)) return;
+            retire(handle.index);
+        }
+        
+        void clear() {
+            for(auto index : active) {
+                ++slots[index].generation;
+                free_slots.push_back(index);
+            }
+            active.clear();
+            completed.clear();
+        }
+        
+        void setClock(const Clock &clock)
+        { this->clock = &clock; }
+        
+        void update()
+        { update(clock->getElapsedTimef()); }
+        
+        void update(float now) {
+            const auto begin = std::chrono::steady_clock::now();
+            completed.clear();
+            stats.num_started = 0;
+            // retire() moves last active fade to position i, so i is advanced only when fade is kept.
+            for(std::size_t i = 0; i < active.size();) {
+                const std::uint32_t index = active[i];
+                Slot &slot = slots[index];
+                if(slot.is_pending) {
+                    slot.start_time = now;
+                    slot.is_pending = false;
+                    ++stats.num_started;
+                }
+                const float elapsed = now - slot.start_time;
+                slot.progress = 0.0f < slot.duration ? std::min(std::max(elapsed / slot.duration, 0.0f), 1.0f) : 1.0f;
+                slot.mix = std::min(std::max(slot.curve(slot.progress), 0.0f), 1.0f);
+                if(slot.duration <= elapsed) {
+                    completed.push_back(Handle{index, slot.generation});
+                    retire(index);
+                } else {
+                    ++i;
+                }
+            }
+            stats.num_completed = completed.size();
+            stats.num_active = active.size();
+            stats.capacity = slots.size();
+            stats.update_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+            ++stats.total_updates;
+        }
+        
+        bool isActive(Handle handle) const {
+            return handle.index < slots.size()
+                && slots[handle.index].generation == handle.generation;
+        }
+        
+        // 0.0 - 1.0. 1.0 for completed / invalid handle
+        float getProgress(Handle handle) const
+        { return isActive(handle) ? slots[handle.index].progress : 1.0f; }
+        
+        // curve(progress) clamped to 0.0 - 1.0, same as CrossFade::getMix
+        float getMix(Handle handle) const
+        { return isActive(handle) ? slots[handle.index].mix : 1.0f; }
+        
+        // same as alpha of CrossFade (0 - 255)
+        float getAlpha(Handle handle) const
+        { return getMix(handle) * 255.0f; }
+        
+        // draws with same blending as CrossFade::draw. does nothing for completed fade.
+        void draw(Handle handle, float x, float y, float width, float height) const {
+            if(!isActive(handle)) return;
+            const Slot &slot = slots[handle.index];
+            ofSetColor(255, 255, 255);
+            slot.from->draw(x, y, width, height);
+            ofSetColor(255, 255, 255, slot.mix * 255.0f);
+            slot.to->draw(x, y, width, height);
+        }
+        
+        // fades completed in last update()
+        const std::vector<Handle> &getCompleted() const
+        { return completed; }
+        
+        std::size_t numActive() const
+        { return active.size(); }
+        
+        const Stats &getStats() const
+        { return stats; }
+    
+    protected:
+        struct Slot {
+            const ofBaseDraws *from{nullptr};
+            const ofBaseDraws *to{nullptr};
+            float start_time{0.0f};
+            float duration{0.0f};
+            float progress{0.0f};
+            float mix{0.0f};
+            EasingCurve curve;
+            std::uint32_t generation{1}; // Handle{} (generation 0) is never valid. bumped on retire
+            std::uint32_t active_position{0};
+            bool is_pending{false};
+        };
+        
+        void retire(std::uint32_t index) {
+            Slot &slot = slots[index];
+            const std::uint32_t position = slot.active_position;
+            active[position] = active.back();
+            slots[active[position]].active_position = position;
+            active.pop_back();
+            ++slot.generation;
+            free_slots.push_back(index);
+        }
+        
+        std::vector<Slot> slots;
+        std::vector<std::uint32_t> active;
+        std::vector<std::uint32_t> free_slots;
+        std::vector<Handle> completed;
+        Stats stats;
+        const Clock *clock{&Clock::shared()};
+    };
+}; // namespace ofx
+
+using ofxCrossFadeScheduler = ofx::CrossFadeScheduler;
+
+#endif /* ofxCrossFadeScheduler_h */
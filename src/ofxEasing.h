@@ -0,0 +1,270 @@
+//
+//  ofxEasing.h
+//
+//  Created by 2bit on 2025/03/19.
+//
+
+#ifndef ofxEasing_h
+#define ofxEasing_h
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#if defined(__AVX2__)
+#   include <immintrin.h>
+#endif
+
+namespace ofx {
+    // easing functions. t is 0.0 - 1.0
+    namespace easing {
+        constexpr float linear(float t)
+        { return t; }
+        
+        constexpr float inQuad(float t)
+        { return t * t; }
+        constexpr float outQuad(float t)
+        { return t * (2.0f - t); }
+        constexpr float inOutQuad(float t)
+        { return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t; }
+        
+        constexpr float inCubic(float t)
+        { return t * t * t; }
+        constexpr float outCubic(float t)
+        { return (t - 1.0f) * (t - 1.0f) * (t - 1.0f) + 1.0f; }
+        constexpr float inOutCubic(float t)
+        { return t < 0.5f ? 4.0f * t * t * t : (t - 1.0f) * (2.0f * t - 2.0f) * (2.0f * t - 2.0f) + 1.0f; }
+        
+        constexpr float inQuart(float t)
+        { return t * t * t * t; }
+        constexpr float outQuart(float t)
+        { return 1.0f - (t - 1.0f) * (t - 1.0f) * (t - 1.0f) * (t - 1.0f); }
+        constexpr float inOutQuart(float t)
+        { return t < 0.5f ? 8.0f * t * t * t * t : 1.0f - 8.0f * (t - 1.0f) * (t - 1.0f) * (t - 1.0f) * (t - 1.0f); }
+        
+        constexpr float smoothStep(float t)
+        { return t * t * (3.0f - 2.0f * t); }
+        constexpr float smootherStep(float t)
+        { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+        
+        constexpr float inBack(float t)
+        { return t * t * (2.70158f * t - 1.70158f); }
+        constexpr float outBack(float t)
+        { return 1.0f + (t - 1.0f) * (t - 1.0f) * (2.70158f * (t - 1.0f) + 1.70158f); }
+        
+        // std::sin etc. aren't constexpr, so they are tabulated at load time.
+        inline float inSine(float t)
+        { return 1.0f - std::cos(t * 1.57079632679f); }
+        inline float outSine(float t)
+        { return std::sin(t * 1.57079632679f); }
+        inline float inOutSine(float t)
+        { return 0.5f - 0.5f * std::cos(t * 3.14159265359f); }
+        
+        inline float inExpo(float t)
+        { return t <= 0.0f ? 0.0f : std::pow(2.0f, 10.0f * t - 10.0f); }
+        inline float outExpo(float t)
+        { return 1.0f <= t ? 1.0f : 1.0f - std::pow(2.0f, -10.0f * t); }
+        
+        inline float inCirc(float t)
+        { return 1.0f - std::sqrt(std::max(0.0f, 1.0f - t * t)); }
+        inline float outCirc(float t)
+        { return std::sqrt(std::max(0.0f, 1.0f - (t - 1.0f) * (t - 1.0f))); }
+    };
+    
+    enum class Ease {
+        Linear,
+        InQuad, OutQuad, InOutQuad,
+        InCubic, OutCubic, InOutCubic,
+        InQuart, OutQuart, InOutQuart,
+        SmoothStep, SmootherStep,
+        InBack, OutBack,
+        InSine, OutSine, InOutSine,
+        InExpo, OutExpo,
+        InCirc, OutCirc,
+        NumEases
+    };
+    
+    inline float ease(Ease type, float t) {
+        t = std::min(std::max(t, 0.0f), 1.0f);
+        switch(type) {
+            case Ease::Linear: return easing::linear(t);
+            case Ease::InQuad: return easing::inQuad(t);
+            case Ease::OutQuad: return easing::outQuad(t);
+            case Ease::InOutQuad: return easing::inOutQuad(t);
+            case Ease::InCubic: return easing::inCubic(t);
+            case Ease::OutCubic: return easing::outCubic(t);
+            case Ease::InOutCubic: return easing::inOutCubic(t);
+            case Ease::InQuart: return easing::inQuart(t);
+            case Ease::OutQuart: return easing::outQuart(t);
+            case Ease::InOutQuart: return easing::inOutQuart(t);
+            case Ease::SmoothStep: return easing::smoothStep(t);
+            case Ease::SmootherStep: return easing::smootherStep(t);
+            case Ease::InBack: return easing::inBack(t);
+            case Ease::OutBack: return easing::outBack(t);
+            case Ease::InSine: return easing::inSine(t);
+            case Ease::OutSine: return easing::outSine(t);
+            case Ease::InOutSine: return easing::inOutSine(t);
+            case Ease::InExpo: return easing::inExpo(t);
+            case Ease::OutExpo: return easing::outExpo(t);
+            case Ease::InCirc: return easing::inCirc(t);
+            case Ease::OutCirc: return easing::outCirc(t);
+            default: return t;
+        }
+    }
+    
+    // lookup table of curve sampled at resolution + 1 points on [0, 1]
+    constexpr std::size_t easing_table_resolution = 256;
+    using EasingTable = std::array<float, easing_table_resolution + 1>;
+    
+    template <typename function_type>
+    constexpr EasingTable makeEasingTable(function_type f) {
+        EasingTable table{};
+        for(std::size_t i = 0; i <= easing_table_resolution; ++i) {
+            table[i] = f(static_cast<float>(i) / easing_table_resolution);
+        }
+        return table;
+    }
+    
+    // css style cubic bezier with control points (x1, y1), (x2, y2). (0, 0) and (1, 1) are fixed.
+    // constexpr, so table can be made at compile time:
+    //     static constexpr auto table = ofx::makeEasingTable(ofx::CubicBezier{0.25f, 0.1f, 0.25f, 1.0f});
+    struct CubicBezier {
+        constexpr CubicBezier(float x1, float y1, float x2, float y2)
+        : x1{std::min(std::max(x1, 0.0f), 1.0f)}
+        , y1{y1}
+        , x2{std::min(std::max(x2, 0.0f), 1.0f)}
+        , y2{y2}
+        {}
+        
+        constexpr float operator()(float x) const
+        { return sample(y1, y2, solve(x)); }
+    
+    private:
+        static constexpr float sample(float p1, float p2, float t)
+        { return ((1.0f + 3.0f * (p1 - p2)) * t + (3.0f * p2 - 6.0f * p1)) * t * t + 3.0f * p1 * t; }
+        
+        static constexpr float slope(float p1, float p2, float t)
+        { return 3.0f * (1.0f + 3.0f * (p1 - p2)) * t * t + 2.0f * (3.0f * p2 - 6.0f * p1) * t + 3.0f * p1; }
+        
+        // parameter t of given x. newton's method, then bisection if it doesn't converge
+        constexpr float solve(float x) const {
+            float t = x;
+            for(int i = 0; i < 8; ++i) {
+                const float error = sample(x1, x2, t) - x;
+                if(-1e-6f < error && error < 1e-6f) return t;
+                const float d = slope(x1, x2, t);
+                if(-1e-6f < d && d < 1e-6f) break;
+                t -= error / d;
+            }
+            float low = 0.0f, high = 1.0f;
+            t = x;
+            for(int i = 0; i < 32; ++i) {
+                const float value = sample(x1, x2, t);
+                if(-1e-6f < value - x && value - x < 1e-6f) break;
+                if(value < x) low = t;
+                else high = t;
+                t = (low + high) * 0.5f;
+            }
+            return t;
+        }
+        
+        float x1, y1, x2, y2;
+    };
+    
+    // easing curve evaluated through lookup table (linear interpolation between samples).
+    // Ease tables are made once at first use and shared. custom table can be
+    // constexpr table (not copied) or any function / CubicBezier (table is owned by curve).
+    // error is < 1e-3 except InCirc / OutCirc near their vertical end (~2e-2). use ease() when it matters.
+    struct EasingCurve {
+        EasingCurve()
+        : EasingCurve{Ease::Linear}
+        {}
+        
+        EasingCurve(Ease type)
+        : table{&shared_table(type)}
+        {}
+        
+        // table must outlive curve (e.g. static constexpr)
+        explicit EasingCurve(const EasingTable &table)
+        : table{&table}
+        {}
+        
+        EasingCurve(const CubicBezier &bezier)
+        : EasingCurve{fromFunction(bezier)}
+        {}
+        
+        template <typename function_type>
+        static EasingCurve fromFunction(function_type f) {
+            EasingCurve curve;
+            curve.owned_table = std::make_shared<EasingTable>(makeEasingTable(f));
+            curve.table = curve.owned_table.get();
+            return curve;
+        }
+        
+        // t is clamped to 0.0 - 1.0
+        float operator()(float t) const {
+            const float x = std::min(std::max(t, 0.0f), 1.0f) * easing_table_resolution;
+            const std::size_t i = std::min(static_cast<std::size_t>(x), easing_table_resolution - 1);
+            const float a = (*table)[i];
+            return a + ((*table)[i + 1] - a) * (x - i);
+        }
+        
+        // values[i] = curve(phases[i])
+        void evaluate(const float *phases, float *values, std::size_t size) const {
+            std::size_t i = 0;
+#if defined(__AVX2__)
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 scale = _mm256_set1_ps(static_cast<float>(easing_table_resolution));
+            const __m256i last = _mm256_set1_epi32(static_cast<int>(easing_table_resolution - 1));
+            for(; i + 8 <= size; i += 8) {
+                const __m256 t = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(phases + i), zero), one);
+                const __m256 x = _mm256_mul_ps(t, scale);
+                const __m256i index = _mm256_min_epi32(_mm256_cvttps_epi32(x), last);
+                const __m256 a = _mm256_i32gather_ps(table->data(), index, 4);
+                const __m256 b = _mm256_i32gather_ps(table->data() + 1, index, 4);
+                const __m256 fraction = _mm256_sub_ps(x, _mm256_cvtepi32_ps(index));
+                _mm256_storeu_ps(values + i, _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), fraction)));
+            }
+#endif
+            for(; i < size; ++i) values[i] = (*this)(phases[i]);
+        }
+        
+        // phases[i] += rates[i] * delta (clamped to 1.0), then values[i] = curve(phases[i]).
+        // rate is 1 / duration.
+        void advance(float *phases, const float *rates, float delta, float *values, std::size_t size) const {
+            for(std::size_t i = 0; i < size; ++i) {
+                phases[i] = std::min(phases[i] + rates[i] * delta, 1.0f);
+            }
+            evaluate(phases, values, size);
+        }
+        
+        const EasingTable &getTable() const
+        { return *table; }
+    
+    private:
+        static const EasingTable &shared_table(Ease type) {
+            static const auto tables = [] {
+                std::array<EasingTable, static_cast<std::size_t>(Ease::NumEases)> tables;
+                for(std::size_t i = 0; i < tables.size(); ++i) {
+                    tables[i] = makeEasingTable([i](float t) { return ease(static_cast<Ease>(i), t); });
+                }
+                return tables;
+            }();
+            const std::size_t index = static_cast<std::size_t>(type);
+            return tables[index < tables.size() ? index : 0];
+        }
+        
+        const EasingTable *table;
+        std::shared_ptr<const EasingTable> owned_table;
+    };
+}; // namespace ofx
+
+using ofxEase = ofx::Ease;
+using ofxEasingCurve = ofx::EasingCurve;
+using ofxCubicBezier = ofx::CubicBezier;
+
+#endif /* ofxEasing_h */
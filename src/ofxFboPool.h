@@ -0,0 +1,184 @@
+//
+//  ofxFboPool.h
+//
+//  Created by 2bit on 2025/03/21.
+//
+
+#ifndef ofxFboPool_h
+#define ofxFboPool_h
+
+#include "ofFbo.h"
+#include "ofGLUtils.h"
+#include "ofGraphics.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ofx {
+    // pool of render targets keyed by ofFboSettings.
+    // lease() gives cleared fbo, which goes back to the pool (not freed) when the last copy of lease is destroyed.
+    // fbos with same settings are reused, so many effect chains which are idle most of time
+    // share few targets as long as they release leases while idle.
+    // GL objects, so use it only from GL thread.
+    //
+    //     auto fbo = ofxFboPool::shared().lease(settings);
+    //     fbo->begin(); ... fbo->end();
+    //     fbo.reset(); // back to pool
+    struct FboPool {
+        using Lease = std::shared_ptr<ofFbo>;
+        
+        // bytes are estimated from settings (color buffers, msaa samples and resolved textures, depth / stencil)
+        struct Stats {
+            std::size_t num_leased{0};
+            std::size_t num_free{0};
+            std::size_t num_allocations{0};
+            std::size_t num_reuses{0};
+            std::size_t bytes_in_use{0};
+            std::size_t bytes_free{0};
+            std::size_t max_bytes_in_use{0};
+            std::size_t max_bytes_allocated{0};
+            
+            std::size_t bytesAllocated() const
+            { return bytes_in_use + bytes_free; }
+        };
+        
+        static FboPool &shared() {
+            static FboPool pool;
+            return pool;
+        }
+        
+        FboPool()
+        : state{std::make_shared<State>()}
+        {}
+        
+        FboPool(const FboPool &) = delete;
+        FboPool &operator=(const FboPool &) = delete;
+        
+        Lease lease(const ofFboSettings &settings) {
+            const std::size_t index = state->find_bucket(settings);
+            auto &bucket = state->buckets[index];
+            auto &stats = state->stats;
+            std::unique_ptr<ofFbo> fbo;
+            if(bucket.free_fbos.empty()) {
+                fbo.reset(new ofFbo());
+                fbo->allocate(settings);
+                ++stats.num_allocations;
+            } else {
+                fbo = std::move(bucket.free_fbos.back());
+                bucket.free_fbos.pop_back();
+                --stats.num_free;
+                stats.bytes_free -= bucket.bytes;
+                ++stats.num_reuses;
+            }
+            fbo->begin();
+            ofClear(0, 0, 0, 0);
+            fbo->end();
+            
+            ++stats.num_leased;
+            stats.bytes_in_use += bucket.bytes;
+            stats.max_bytes_in_use = std::max(stats.max_bytes_in_use, stats.bytes_in_use);
+            stats.max_bytes_allocated = std::max(stats.max_bytes_allocated, stats.bytesAllocated());
+            
+            std::weak_ptr<State> weak_state = state;
+            return Lease(fbo.release(), [weak_state, index](ofFbo *fbo) {
+                if(auto state = weak_state.lock()) state->give_back(index, fbo);
+                else delete fbo;
+            });
+        }
+        
+        // frees fbos which are not leased now
+        void purge() {
+            for(auto &bucket : state->buckets) bucket.free_fbos.clear();
+            state->stats.num_free = 0;
+            state->stats.bytes_free = 0;
+        }
+        
+        // sets high-water marks to current values
+        void resetHighWaterMarks() {
+            auto &stats = state->stats;
+            stats.max_bytes_in_use = stats.bytes_in_use;
+            stats.max_bytes_allocated = stats.bytesAllocated();
+        }
+        
+        const Stats &getStats() const
+        { return state->stats; }
+        
+        static std::size_t estimateBytes(const ofFboSettings &settings) {
+            const std::size_t num_pixels = static_cast<std::size_t>(std::max(settings.width, 0)) * std::max(settings.height, 0);
+            std::size_t color_bytes = 0;
+            if(settings.colorFormats.empty()) {
+                color_bytes = bytes_per_pixel(settings.internalformat) * std::max(settings.numColorbuffers, 1);
+            } else {
+                for(auto format : settings.colorFormats) color_bytes += bytes_per_pixel(format);
+            }
+            const std::size_t num_samples = std::max(settings.numSamples, 1);
+            std::size_t bytes = num_pixels * color_bytes * num_samples;
+            if(0 < settings.numSamples) bytes += num_pixels * color_bytes; // resolved textures
+            if(settings.useDepth || settings.useStencil) bytes += num_pixels * 4 * num_samples;
+            return bytes;
+        }
+        
+        static bool isSameSettings(const ofFboSettings &x, const ofFboSettings &y) {
+            return x.width == y.width
+                && x.height == y.height
+                && x.numColorbuffers == y.numColorbuffers
+                && x.colorFormats == y.colorFormats
+                && x.useDepth == y.useDepth
+                && x.useStencil == y.useStencil
+                && x.depthStencilAsTexture == y.depthStencilAsTexture
+                && x.textureTarget == y.textureTarget
+                && x.internalformat == y.internalformat
+                && x.depthStencilInternalFormat == y.depthStencilInternalFormat
+                && x.wrapModeHorizontal == y.wrapModeHorizontal
+                && x.wrapModeVertical == y.wrapModeVertical
+                && x.minFilter == y.minFilter
+                && x.maxFilter == y.maxFilter
+                && x.numSamples == y.numSamples;
+        }
+    
+    protected:
+        static std::size_t bytes_per_pixel(GLint internal_format) {
+            const GLenum type = ofGetGLTypeFromInternal(internal_format);
+            const GLenum format = ofGetGLFormatFromInternal(internal_format);
+            return ofGetBytesPerChannelFromGLType(type) * ofGetNumChannelsFromGLFormat(format);
+        }
+        
+        struct Bucket {
+            ofFboSettings settings;
+            std::size_t bytes;
+            std::vector<std::unique_ptr<ofFbo>> free_fbos;
+        };
+        
+        // leases keep weak reference to this, so fbos returned after the pool is destroyed are just deleted
+        struct State {
+            // few kinds of settings in practice, so linear search
+            std::size_t find_bucket(const ofFboSettings &settings) {
+                for(std::size_t i = 0; i < buckets.size(); ++i) {
+                    if(isSameSettings(buckets[i].settings, settings)) return i;
+                }
+                buckets.push_back(Bucket{settings, estimateBytes(settings), {}});
+                return buckets.size() - 1;
+            }
+            
+            void give_back(std::size_t index, ofFbo *fbo) {
+                auto &bucket = buckets[index];
+                bucket.free_fbos.emplace_back(fbo);
+                --stats.num_leased;
+                stats.bytes_in_use -= bucket.bytes;
+                ++stats.num_free;
+                stats.bytes_free += bucket.bytes;
+            }
+            
+            std::vector<Bucket> buckets;
+            Stats stats;
+        };
+        
+        std::shared_ptr<State> state;
+    };
+}; // namespace ofx
+
+using ofxFboPool = ofx::FboPool;
+
+#endif /* ofxFboPool_h */
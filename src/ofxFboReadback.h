@@ -0,0 +1,208 @@
+//
+//  ofxFboReadback.h
+//
+//  Created by 2bit on 2025/03/20.
+//
+
+#ifndef ofxFboReadback_h
+#define ofxFboReadback_h
+
+#include "ofFbo.h"
+#include "ofBufferObject.h"
+#include "ofGLUtils.h"
+#include "ofPixels.h"
+#include "ofLog.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ofx {
+    // asynchronous readback of ofFbo through ring of pixel buffer objects.
+    // queue() starts copy of texture into free PBO and puts fence after it, poll() gives oldest
+    // finished copy without waiting. result is some frames older than current one.
+    // when all PBOs are in flight, queue() drops the request instead of waiting.
+    // on OpenGL ES (no glGetTexImage / glMapBuffer), falls back to synchronous readToPixels.
+    //
+    //     readback.setup(3);
+    //     // every frame, after drawing into fbo
+    //     readback.queue(fbo);
+    //     if(readback.poll(pixels)) recorder.add(pixels);
+    //     // at the end
+    //     while(readback.wait(pixels)) recorder.add(pixels);
+    struct FboReadbackRing {
+        struct Stats {
+            std::uint64_t num_queued{0};
+            std::uint64_t num_completed{0};
+            std::uint64_t num_dropped{0}; // queue() called when all buffers were in flight
+            std::uint64_t last_latency{0}; // in number of queue() (= frames when queued every frame)
+            std::uint64_t max_latency{0};
+            std::uint64_t total_latency{0};
+            
+            double averageLatency() const
+            { return num_completed ? static_cast<double>(total_latency) / num_completed : 0.0; }
+        };
+        
+        FboReadbackRing() = default;
+        FboReadbackRing(const FboReadbackRing &) = delete;
+        FboReadbackRing &operator=(const FboReadbackRing &) = delete;
+        ~FboReadbackRing()
+        { clear(); }
+        
+        void setup(std::size_t num_buffers = 3) {
+            clear();
+            if(num_buffers < 1) num_buffers = 1;
+            slots.resize(num_buffers);
+            write_index = 0;
+            read_index = 0;
+        }
+        
+        // drops in-flight readbacks
+        void clear() {
+            for(auto &slot : slots) release(slot);
+            slots.clear();
+        }
+        
+        bool queue(ofFbo &fbo, int attachment = 0) {
+            if(slots.empty()) setup();
+            ++stats.num_queued;
+            Slot &slot = slots[write_index];
+            if(slot.is_in_flight) {
+                ++stats.num_dropped;
+                return false;
+            }
+            ofTexture &texture = fbo.getTexture(attachment);
+            const auto &data = texture.getTextureData();
+            const GLenum gl_format = ofGetGLFormatFromInternal(data.glInternalFormat);
+            const GLenum gl_type = ofGetGLTypeFromInternal(data.glInternalFormat);
+            slot.width = static_cast<std::size_t>(texture.getWidth());
+            slot.height = static_cast<std::size_t>(texture.getHeight());
+            slot.num_channels = ofGetNumChannelsFromGLFormat(gl_format);
+            slot.bytes_per_channel = ofGetBytesPerChannelFromGLType(gl_type);
+            slot.queued_index = stats.num_queued;
+#ifndef TARGET_OPENGLES
+            const std::size_t size = slot.width * slot.height * slot.num_channels * slot.bytes_per_channel;
+            if(!slot.buffer.isAllocated() || slot.buffer.size() != size) {
+                slot.buffer.allocate(size, GL_STREAM_READ);
+            }
+            texture.copyTo(slot.buffer);
+            slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            slot.is_flushed = false;
+#else
+            // no async path. read now and hand it at next poll()
+            if(slot.bytes_per_channel == 1) fbo.readToPixels(slot.fallback, attachment);
+#endif
+            slot.is_in_flight = true;
+            write_index = (write_index + 1) % slots.size();
+            return true;
+        }
+        
+        // oldest finished readback. returns false without waiting when it is not finished yet.
+        template <typename pixel_type>
+        bool poll(ofPixels_<pixel_type> &pixels)
+        { return read(pixels, false); }
+        
+        // waits oldest readback. returns false when nothing is in flight.
+        template <typename pixel_type>
+        bool wait(ofPixels_<pixel_type> &pixels)
+        { return read(pixels, true); }
+        
+        std::size_t numInFlight() const {
+            std::size_t n = 0;
+            for(const auto &slot : slots) if(slot.is_in_flight) ++n;
+            return n;
+        }
+        
+        std::size_t numBuffers() const
+        { return slots.size(); }
+        
+        const Stats &getStats() const
+        { return stats; }
+    
+    protected:
+        struct Slot {
+            ofBufferObject buffer;
+#ifndef TARGET_OPENGLES
+            GLsync fence{nullptr};
+#else
+            ofPixels fallback;
+#endif
+            std::size_t width{0};
+            std::size_t height{0};
+            std::size_t num_channels{0};
+            std::size_t bytes_per_channel{0};
+            std::uint64_t queued_index{0};
+            bool is_in_flight{false};
+            bool is_flushed{false};
+        };
+        
+        void release(Slot &slot) {
+#ifndef TARGET_OPENGLES
+            if(slot.fence) glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+#endif
+            slot.is_in_flight = false;
+        }
+        
+        template <typename pixel_type>
+        bool read(ofPixels_<pixel_type> &pixels, bool should_wait) {
+            if(slots.empty()) return false;
+            Slot &slot = slots[read_index];
+            if(!slot.is_in_flight) return false;
+#ifndef TARGET_OPENGLES
+            // flush on the first check so that the fence is surely signaled some time
+            const GLbitfield flags = slot.is_flushed ? 0 : GL_SYNC_FLUSH_COMMANDS_BIT;
+            slot.is_flushed = true;
+            GLenum result = glClientWaitSync(slot.fence, flags, should_wait ? 1000000000 : 0);
+            while(should_wait && result == GL_TIMEOUT_EXPIRED) result = glClientWaitSync(slot.fence, 0, 1000000000);
+            if(result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+                if(result == GL_WAIT_FAILED) {
+                    ofLogWarning("ofxFboReadbackRing") << "glClientWaitSync failed. readback is dropped";
+                    release(slot);
+                    read_index = (read_index + 1) % slots.size();
+                    ++stats.num_dropped;
+                }
+                return false;
+            }
+#endif
+            bool is_valid = sizeof(pixel_type) == slot.bytes_per_channel;
+            if(!is_valid) {
+                ofLogWarning("ofxFboReadbackRing") << "pixel type doesn't match texture: "
+                                                   << slot.bytes_per_channel << " bytes per channel";
+            } else {
+#ifndef TARGET_OPENGLES
+                const auto data = static_cast<const pixel_type *>(slot.buffer.map(GL_READ_ONLY));
+                if(data) {
+                    pixels.setFromPixels(data, slot.width, slot.height, slot.num_channels);
+                    slot.buffer.unmap();
+                } else {
+                    is_valid = false;
+                }
+#else
+                pixels.setFromPixels(reinterpret_cast<const pixel_type *>(slot.fallback.getData()),
+                                     slot.width,
+                                     slot.height,
+                                     slot.num_channels);
+#endif
+            }
+            release(slot);
+            read_index = (read_index + 1) % slots.size();
+            if(!is_valid) return false;
+            
+            ++stats.num_completed;
+            stats.last_latency = stats.num_queued - slot.queued_index;
+            stats.max_latency = std::max(stats.max_latency, stats.last_latency);
+            stats.total_latency += stats.last_latency;
+            return true;
+        }
+        
+        std::vector<Slot> slots;
+        std::size_t write_index{0};
+        std::size_t read_index{0};
+        Stats stats;
+    };
+}; // namespace ofx
+
+using ofxFboReadbackRing = ofx::FboReadbackRing;
+
+#endif /* ofxFboReadback_h */
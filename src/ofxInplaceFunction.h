@@ -0,0 +1,162 @@
+//
+//  ofxInplaceFunction.h
+//
+//  Created by 2bit on 2025/03/15.
+//
+
+#ifndef ofxInplaceFunction_h
+#define ofxInplaceFunction_h
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ofx {
+    template <typename signature, std::size_t capacity = 64>
+    struct InplaceFunction;
+    
+    namespace detail {
+        template <typename type>
+        struct is_function_wrapper : std::false_type {};
+        
+        template <typename signature>
+        struct is_function_wrapper<std::function<signature>> : std::true_type {};
+        
+        template <typename signature, std::size_t capacity>
+        struct is_function_wrapper<InplaceFunction<signature, capacity>> : std::true_type {};
+        
+        // null function pointer / member pointer and empty std::function are wrapped as empty
+        template <typename type>
+        bool is_null_callable(const type &f) {
+            if constexpr(std::is_pointer<type>::value || std::is_member_pointer<type>::value) {
+                return f == nullptr;
+            } else if constexpr(is_function_wrapper<type>::value) {
+                return !f;
+            } else {
+                return false;
+            }
+        }
+    };
+    
+    // std::function like wrapper which stores callable in fixed size buffer inside itself.
+    // it never allocates. callable larger than capacity (or whose move may throw) is a compile error.
+    // callable is called by std::invoke, so member pointers can be stored too.
+    template <typename result_type, typename ... arguments, std::size_t capacity>
+    struct InplaceFunction<result_type(arguments ...), capacity> {
+        InplaceFunction() = default;
+        InplaceFunction(std::nullptr_t) {}
+        
+        template <
+            typename function_type,
+            typename stored_type = typename std::decay<function_type>::type,
+            typename = typename std::enable_if<
+                !std::is_same<stored_type, InplaceFunction>::value
+                && std::is_invocable_r<result_type, stored_type &, arguments ...>::value
+            >::type
+        >
+        InplaceFunction(function_type &&f) {
+            static_assert(sizeof(stored_type) <= capacity,
+                          "callable is too large for InplaceFunction. capture less or increase capacity");
+            static_assert(alignof(stored_type) <= alignof(std::max_align_t),
+                          "callable is over-aligned for InplaceFunction");
+            static_assert(std::is_copy_constructible<stored_type>::value,
+                          "callable must be copy constructible");
+            // move of InplaceFunction moves the callable and is noexcept
+            static_assert(std::is_nothrow_move_constructible<stored_type>::value,
+                          "callable must be nothrow move constructible");
+            if(detail::is_null_callable(f)) return;
+            new (storage) stored_type(std::forward<function_type>(f));
+            ops = &ops_for<stored_type>::value;
+        }
+        
+        InplaceFunction(const InplaceFunction &x) {
+            if(x.ops) x.ops->copy(storage, x.storage);
+            ops = x.ops;
+        }
+        
+        InplaceFunction(InplaceFunction &&x) noexcept {
+            if(x.ops) x.ops->move(storage, x.storage);
+            ops = x.ops;
+            x.ops = nullptr;
+        }
+        
+        ~InplaceFunction()
+        { reset(); }
+        
+        InplaceFunction &operator=(const InplaceFunction &x) {
+            if(this == &x) return *this;
+            reset();
+            if(x.ops) x.ops->copy(storage, x.storage);
+            ops = x.ops;
+            return *this;
+        }
+        
+        InplaceFunction &operator=(InplaceFunction &&x) noexcept {
+            if(this == &x) return *this;
+            reset();
+            if(x.ops) x.ops->move(storage, x.storage);
+            ops = x.ops;
+            x.ops = nullptr;
+            return *this;
+        }
+        
+        InplaceFunction &operator=(std::nullptr_t) {
+            reset();
+            return *this;
+        }
+        
+        void reset() {
+            if(ops) ops->destroy(storage);
+            ops = nullptr;
+        }
+        
+        explicit operator bool() const
+        { return ops != nullptr; }
+        
+        result_type operator()(arguments ... args) const {
+            if(!ops) throw std::bad_function_call();
+            return ops->invoke(storage, std::forward<arguments>(args) ...);
+        }
+    
+    private:
+        struct operations {
+            result_type (*invoke)(void *, arguments && ...);
+            void (*copy)(void *, const void *);
+            void (*move)(void *, void *);
+            void (*destroy)(void *);
+        };
+        
+        template <typename stored_type>
+        struct ops_for {
+            // result of callable is discarded when result_type is void (same as std::function)
+            static result_type invoke(void *f, arguments && ... args) {
+                if constexpr(std::is_void<result_type>::value) {
+                    std::invoke(*static_cast<stored_type *>(f), std::forward<arguments>(args) ...);
+                } else {
+                    return std::invoke(*static_cast<stored_type *>(f), std::forward<arguments>(args) ...);
+                }
+            }
+            static void copy(void *dst, const void *src)
+            { new (dst) stored_type(*static_cast<const stored_type *>(src)); }
+            // moved-from callable is destroyed here and its InplaceFunction becomes empty
+            static void move(void *dst, void *src) {
+                new (dst) stored_type(std::move(*static_cast<stored_type *>(src)));
+                static_cast<stored_type *>(src)->~stored_type();
+            }
+            static void destroy(void *f)
+            { static_cast<stored_type *>(f)->~stored_type(); }
+            static constexpr operations value{invoke, copy, move, destroy};
+        };
+        
+        // mutable as std::function, callable with non-const operator() can be called from const this
+        alignas(std::max_align_t) mutable unsigned char storage[capacity];
+        const operations *ops{nullptr};
+    };
+}; // namespace ofx
+
+template <typename signature, std::size_t capacity = 64>
+using ofxInplaceFunction = ofx::InplaceFunction<signature, capacity>;
+
+#endif /* ofxInplaceFunction_h */
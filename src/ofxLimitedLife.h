@@ -4,13 +4,14 @@
 #define OFXLIMITEDLIFE_H
 
 #include "ofUtils.h"
+#include "ofxClock.h"
 
 #include <bbb/snippets/limited_life.hpp>
 
-template <typename base_type, float time_func() = ofGetElapsedTimef>
+template <typename base_type, float time_func() = ofx::getElapsedTimef>
 using ofxLimitedLifeInjector = bbb::limited_life_injector<base_type, time_func>;
 
-template <typename base_type, float time_func() = ofGetElapsedTimef>
+template <typename base_type, float time_func() = ofx::getElapsedTimef>
 using ofxLimitedLife = bbb::limited_life<base_type, time_func>;
 
 #endif // OFXLIMITEDLIFE_H
@@ -0,0 +1,124 @@
+//
+//  ofxLockFreeQueue.h
+//
+//  Created by 2bit on 2025/03/10.
+//
+
+#ifndef ofxLockFreeQueue_h
+#define ofxLockFreeQueue_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace ofx {
+    // bounded multi-producer queue (D. Vyukov's array based queue).
+    // push / pop never block. when full, push fails and counts as dropped.
+    template <typename value_type>
+    struct LockFreeQueue {
+        explicit LockFreeQueue(std::size_t capacity)
+        : mask{round_up(capacity) - 1}
+        , cells{new cell[mask + 1]}
+        {
+            for(std::size_t i = 0; i <= mask; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        
+        LockFreeQueue(const LockFreeQueue &) = delete;
+        LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+        
+        ~LockFreeQueue() {
+            auto tail = enqueue_pos.load(std::memory_order_relaxed);
+            for(auto pos = dequeue_pos.load(std::memory_order_relaxed); pos != tail; ++pos) {
+                cell &c = cells[pos & mask];
+                if(c.sequence.load(std::memory_order_relaxed) == pos + 1) {
+                    std::launder(reinterpret_cast<value_type *>(c.storage))->~value_type();
+                }
+            }
+        }
+        
+        template <typename ... arguments>
+        bool push(arguments && ... args) {
+            std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            cell *c;
+            while(true) {
+                c = &cells[pos & mask];
+                std::size_t seq = c->sequence.load(std::memory_order_acquire);
+                std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if(diff == 0) {
+                    if(enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if(diff < 0) {
+                    num_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                } else {
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            new (c->storage) value_type(std::forward<arguments>(args) ...);
+            c->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+        
+        bool pop(value_type &value) {
+            std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+            cell *c;
+            while(true) {
+                c = &cells[pos & mask];
+                std::size_t seq = c->sequence.load(std::memory_order_acquire);
+                std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+                if(diff == 0) {
+                    if(dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if(diff < 0) {
+                    return false;
+                } else {
+                    pos = dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            value_type *stored = std::launder(reinterpret_cast<value_type *>(c->storage));
+            value = std::move(*stored);
+            stored->~value_type();
+            c->sequence.store(pos + mask + 1, std::memory_order_release);
+            return true;
+        }
+        
+        std::size_t capacity() const
+        { return mask + 1; }
+        
+        // approximate when producers are running
+        std::size_t size() const {
+            auto tail = enqueue_pos.load(std::memory_order_relaxed);
+            auto head = dequeue_pos.load(std::memory_order_relaxed);
+            return head < tail ? tail - head : 0;
+        }
+        
+        std::uint64_t numDropped() const
+        { return num_dropped.load(std::memory_order_relaxed); }
+    
+    protected:
+        struct cell {
+            std::atomic<std::size_t> sequence;
+            alignas(value_type) unsigned char storage[sizeof(value_type)];
+        };
+        
+        static std::size_t round_up(std::size_t n) {
+            std::size_t p = 2;
+            while(p < n) p <<= 1;
+            return p;
+        }
+        
+        const std::size_t mask;
+        std::unique_ptr<cell[]> cells;
+        alignas(64) std::atomic<std::size_t> enqueue_pos{0};
+        alignas(64) std::atomic<std::size_t> dequeue_pos{0};
+        alignas(64) std::atomic<std::uint64_t> num_dropped{0};
+    };
+}; // namespace ofx
+
+template <typename value_type>
+using ofxLockFreeQueue = ofx::LockFreeQueue<value_type>;
+
+#endif /* ofxLockFreeQueue_h */
@@ -11,28 +11,57 @@
 #include "ofGLBaseTypes.h"
 #include "ofGraphicsBaseTypes.h"
 
+#include "ofxFboPool.h"
+#include "ofxFboReadback.h"
+
+#include <algorithm>
+#include <memory>
+
 namespace ofx {
+    // fbos are leased from FboPool lazily, i.e. on first begin() (or other non-const access to the fbo),
+    // and are returned by release() or destruction. leased fbo is cleared.
+    // const methods (draw(), const getTexture(), readToPixels(), ...) never lease, so they see empty fbo / texture
+    // while the buffer is not leased. same for any access before allocate().
+    // copy has same settings and pool but its own buffers (leased lazily again) and own readback ring.
     struct PingPongFbo : public ofBaseDraws, public ofBaseHasTexture {
-        void allocate(ofFboSettings settings, std::size_t num_fbo = 2) {
+        PingPongFbo() = default;
+        PingPongFbo(const PingPongFbo &x)
+        : ofBaseDraws(x)
+        , ofBaseHasTexture(x)
+        { copy_from(x); }
+        PingPongFbo(PingPongFbo &&) = default;
+        
+        PingPongFbo &operator=(const PingPongFbo &x) {
+            if(this != &x) copy_from(x);
+            return *this;
+        }
+        PingPongFbo &operator=(PingPongFbo &&) = default;
+        
+        void allocate(ofFboSettings settings, std::size_t num_fbo = 2, FboPool &pool = FboPool::shared()) {
             if(num_fbo < 2) {
                 ofLogWarning("ofxPingPongFbo") << "num_fbo must be 2 or more. now num_fbo is setted to 2.";
                 num_fbo = 2;
             }
             current_fbo_index = 0;
+            this->settings = settings;
+            this->pool = &pool;
+            fbos.clear();
             fbos.resize(num_fbo);
-            for(auto& fbo : fbos) {
-                fbo.allocate(settings);
-                fbo.begin();
-                ofClear(0, 0, 0, 0);
-                fbo.end();
-            }
         }
         
+        // returns fbos to pool. contents are lost, next access leases cleared fbos again
+        void release() {
+            for(auto &fbo : fbos) fbo.reset();
+        }
+        
+        std::size_t numLeased() const
+        { return std::count_if(fbos.begin(), fbos.end(), [](const FboPool::Lease &fbo) { return static_cast<bool>(fbo); }); }
+        
         void setAutomaticallyNextWithEnd(bool automatically_next_with_end) {
             this->automatically_next_with_end = automatically_next_with_end;
         }
         
-        void begin(ofFboMode mode = OF_FBOMODE_PERSPECTIVE | OF_FBOMODE_MATRIXFLIP) const {
+        void begin(ofFboMode mode = OF_FBOMODE_PERSPECTIVE | OF_FBOMODE_MATRIXFLIP) {
             currentFbo().begin(mode);
         }
         
@@ -45,12 +74,34 @@ namespace ofx {
             if(with_next) next();
         }
 
+        // pixels is cleared when current buffer is not leased (nothing is drawn yet)
         void readToPixels(ofPixels & pixels, int attachmentPoint = 0) const
-        { currentFbo().readToPixels(pixels, attachmentPoint); }
+        { read_to_pixels(pixels, attachmentPoint); }
         void readToPixels(ofShortPixels & pixels, int attachmentPoint = 0) const
-        { currentFbo().readToPixels(pixels, attachmentPoint); }
+        { read_to_pixels(pixels, attachmentPoint); }
         void readToPixels(ofFloatPixels & pixels, int attachmentPoint = 0) const
-        { currentFbo().readToPixels(pixels, attachmentPoint); }
+        { read_to_pixels(pixels, attachmentPoint); }
+        
+        // async readback through ring of num_buffers PBOs. see ofxFboReadbackRing
+        void setupAsyncReadback(std::size_t num_buffers = 3) {
+            if(!readback) readback = std::make_shared<FboReadbackRing>();
+            readback->setup(num_buffers);
+        }
+        
+        // queues current fbo and gets oldest finished readback without blocking.
+        // returns false when nothing is finished yet (pixels is not touched).
+        // latency and dropped readbacks are in getAsyncReadback().getStats()
+        template <typename pixel_type>
+        bool readToPixelsAsync(ofPixels_<pixel_type> &pixels, int attachmentPoint = 0) {
+            if(!readback) setupAsyncReadback();
+            readback->queue(currentFbo(), attachmentPoint);
+            return readback->poll(pixels);
+        }
+        
+        FboReadbackRing &getAsyncReadback() {
+            if(!readback) setupAsyncReadback();
+            return *readback;
+        }
         
         void bind() const
         { currentFbo().bind(); }
@@ -59,27 +110,28 @@ namespace ofx {
         { currentFbo().unbind(); }
         
         void next() const {
+            if(size() == 0) return;
             current_fbo_index = (current() + 1) % size();
         }
         
         using ofBaseDraws::draw;
         void draw(float x, float y, float w, float h) const override
-        { currentFbo().draw(x, y, w, h); }
+        { if(currentFbo().isAllocated()) currentFbo().draw(x, y, w, h); }
         
         float getWidth() const override
-        { return currentFbo().getWidth(); }
+        { return settings.width; }
         float getHeight() const override
-        { return currentFbo().getHeight(); }
+        { return settings.height; }
         
         ofTexture &getTexture() override
-        { return currentFbo().getTexture(); }
+        { return currentFbo().isAllocated() ? currentFbo().getTexture() : empty_texture(); }
         const ofTexture &getTexture() const override
-        { return currentFbo().getTexture(); }
+        { return currentFbo().isAllocated() ? currentFbo().getTexture() : empty_texture(); }
         
         ofTexture &getTexture(int attachmentPoint)
-        { return currentFbo().getTexture(attachmentPoint); }
+        { return currentFbo().isAllocated() ? currentFbo().getTexture(attachmentPoint) : empty_texture(); }
         const ofTexture &getTexture(int attachmentPoint) const
-        { return currentFbo().getTexture(attachmentPoint); }
+        { return currentFbo().isAllocated() ? currentFbo().getTexture(attachmentPoint) : empty_texture(); }
         
         ofTexture &getDepthTexture()
         { return currentFbo().getDepthTexture(); }
@@ -89,15 +141,10 @@ namespace ofx {
         void setUseTexture(bool) override {};
         bool isUsingTexture() const override { return true; }
 
-        ofFbo &operator[](std::int64_t n) {
-            while(n < 0) n += size();
-            return fbos[(current() + n) % size()];
-        }
-        
-        const ofFbo &operator[](std::int64_t n) const {
-            while(n < 0) n += size();
-            return fbos[(current() + n) % size()];
-        }
+        ofFbo &operator[](std::int64_t n)
+        { return fbo_at(offset_index(n)); }
+        const ofFbo &operator[](std::int64_t n) const
+        { return fbo_at(offset_index(n)); }
         
         std::size_t size() const
         { return fbos.size(); }
@@ -105,19 +152,72 @@ namespace ofx {
         { return current_fbo_index; }
         
         ofFbo &currentFbo()
-        { return fbos[current()]; }
+        { return fbo_at(current()); }
         const ofFbo &currentFbo() const
-        { return fbos[current()]; }
+        { return fbo_at(current()); }
 
         ofFbo &prevFbo(std::size_t n = 1)
-        { return fbos[(current() + size() - n % size()) % size()]; }
+        { return fbo_at(size() ? (current() + size() - n % size()) % size() : 0); }
         const ofFbo &prevFbo(std::size_t n = 1) const
-        { return fbos[(current() + size() - n % size()) % size()]; }
+        { return fbo_at(size() ? (current() + size() - n % size()) % size() : 0); }
         
     protected:
-        std::vector<ofFbo> fbos;
+        std::size_t offset_index(std::int64_t n) const {
+            if(size() == 0) return 0;
+            const auto num = static_cast<std::int64_t>(size());
+            return static_cast<std::size_t>(((static_cast<std::int64_t>(current()) + n) % num + num) % num);
+        }
+        
+        // leases on first access. before allocate(), gives empty fbo with warning
+        ofFbo &fbo_at(std::size_t index) {
+            if(pool == nullptr || fbos.size() <= index) {
+                ofLogWarning("ofxPingPongFbo") << "fbo is used before allocate().";
+                return empty_fbo();
+            }
+            auto &fbo = fbos[index];
+            if(!fbo) fbo = pool->lease(settings);
+            return *fbo;
+        }
+        
+        // doesn't lease. buffer not leased yet is empty fbo
+        const ofFbo &fbo_at(std::size_t index) const {
+            if(fbos.size() <= index || !fbos[index]) return empty_fbo();
+            return *fbos[index];
+        }
+        
+        static ofFbo &empty_fbo() {
+            static ofFbo fbo;
+            return fbo;
+        }
+        
+        static ofTexture &empty_texture() {
+            static ofTexture texture;
+            return texture;
+        }
+        
+        template <typename pixels_type>
+        void read_to_pixels(pixels_type &pixels, int attachmentPoint) const {
+            if(currentFbo().isAllocated()) currentFbo().readToPixels(pixels, attachmentPoint);
+            else pixels.clear();
+        }
+        
+        void copy_from(const PingPongFbo &x) {
+            settings = x.settings;
+            pool = x.pool;
+            fbos.clear();
+            fbos.resize(x.fbos.size());
+            current_fbo_index = x.current_fbo_index;
+            automatically_next_with_end = x.automatically_next_with_end;
+            readback.reset();
+            if(x.readback) setupAsyncReadback(x.readback->numBuffers());
+        }
+        
+        ofFboSettings settings;
+        FboPool *pool{nullptr};
+        std::vector<FboPool::Lease> fbos;
         mutable std::size_t current_fbo_index{0};
         bool automatically_next_with_end{false};
+        std::shared_ptr<FboReadbackRing> readback;
     };
 }; // namespace ofx
 
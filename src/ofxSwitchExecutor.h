@@ -8,38 +8,841 @@
 #ifndef ofxSwitchExecutor_h
 #define ofxSwitchExecutor_h
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ofxInplaceFunction.h"
 
 namespace ofx {
-    template <typename enum_like>
-    struct SwitchExecutor {
-        void action(enum_like value, std::function<void()> action) {
-            actions[value] = action;
+    namespace detail {
+        template <typename enum_like, typename = void>
+        struct switch_key_traits {
+            static constexpr bool is_indexable = false;
+        };
+        
+        template <typename enum_like>
+        struct switch_key_traits<enum_like, typename std::enable_if<std::is_enum<enum_like>::value>::type> {
+            static constexpr bool is_indexable = true;
+            static std::uint64_t to_index(enum_like value)
+            { return static_cast<std::uint64_t>(static_cast<typename std::underlying_type<enum_like>::type>(value)); }
+        };
+        
+        template <typename enum_like>
+        struct switch_key_traits<enum_like, typename std::enable_if<std::is_integral<enum_like>::value>::type> {
+            static constexpr bool is_indexable = true;
+            static std::uint64_t to_index(enum_like value)
+            { return static_cast<std::uint64_t>(value); }
+        };
+        
+        template <typename signature, std::size_t handler_capacity>
+        struct switch_function {
+            using type = InplaceFunction<signature, handler_capacity>;
+        };
+        
+        template <typename signature>
+        struct switch_function<signature, 0> {
+            using type = std::function<signature>;
+        };
+        
+        // runBatch takes lvalue reference parameters as they are, and others by value
+        template <typename argument>
+        using switch_batch_argument = typename std::conditional<
+            std::is_lvalue_reference<argument>::value,
+            argument,
+            typename std::decay<argument>::type
+        >::type;
+    };
+    
+    // instrumentation policies for SwitchExecutor.
+    // policy has Slot (base of each handler), slot(value) called on registration,
+    // and begin(slot) called per dispatch (nullptr for fallback). object returned by begin() lives during the call.
+    
+    // default. everything is empty and optimized out.
+    struct NoSwitchInstrumentation {
+        struct Slot {};
+        struct Scope {};
+        
+        template <typename enum_like>
+        Slot slot(const enum_like &) const
+        { return {}; }
+        
+        Scope begin(const Slot *) const
+        { return {}; }
+    };
+    
+    // counts calls and records latency histogram per key and for fallback.
+    // counters are shared by copies (e.g. snapshots of ConcurrentSwitchExecutor) and are kept after remove().
+    // clock_type can be replaced by cheaper clock. (needs now() and duration convertible to nanoseconds)
+    template <typename enum_like, typename clock_type = std::chrono::steady_clock>
+    struct SwitchInstrumentation {
+        // bucket n counts calls which took [2^(n-1), 2^n) ns. bucket 0 is 0 ns.
+        static constexpr std::size_t num_buckets = 40;
+        
+        struct Stats {
+            std::uint64_t num_calls{0};
+            std::uint64_t total_nanos{0};
+            std::array<std::uint64_t, num_buckets> histogram{};
+            
+            double averageNanos() const
+            { return num_calls ? static_cast<double>(total_nanos) / num_calls : 0.0; }
+            
+            // upper bound of bucket which contains given ratio (0.0 - 1.0) of calls
+            std::uint64_t percentileNanos(double ratio) const {
+                const double threshold = ratio * num_calls;
+                std::uint64_t sum = 0;
+                for(std::size_t i = 0; i < num_buckets; ++i) {
+                    sum += histogram[i];
+                    if(threshold <= sum && histogram[i]) return bucket_upper_bound(i);
+                }
+                return bucket_upper_bound(num_buckets - 1);
+            }
+        };
+        
+        struct Snapshot {
+            std::map<enum_like, Stats> keys;
+            Stats fallback;
+            
+            std::uint64_t numCalls() const {
+                std::uint64_t sum = fallback.num_calls;
+                for(const auto &pair : keys) sum += pair.second.num_calls;
+                return sum;
+            }
+            
+            std::uint64_t numFallbacks() const
+            { return fallback.num_calls; }
+            
+            // one line per key: key, calls, average, p50, p99 (ns). keys are sorted by total time.
+            std::string toString() const {
+                std::vector<std::pair<std::string, const Stats *>> rows;
+                for(const auto &pair : keys) rows.emplace_back(key_to_string(pair.first), &pair.second);
+                rows.emplace_back("fallback", &fallback);
+                std::stable_sort(rows.begin(), rows.end(), [](const auto &x, const auto &y) {
+                    return y.second->total_nanos < x.second->total_nanos;
+                });
+                std::string result;
+                char buffer[160];
+                for(const auto &row : rows) {
+                    const Stats &stats = *row.second;
+                    std::snprintf(buffer, sizeof(buffer), "%-12s calls: %10llu  avg: %10.1fns  p50: <%llu ns  p99: <%llu ns\n",
+                                  row.first.c_str(),
+                                  static_cast<unsigned long long>(stats.num_calls),
+                                  stats.averageNanos(),
+                                  static_cast<unsigned long long>(stats.percentileNanos(0.5)),
+                                  static_cast<unsigned long long>(stats.percentileNanos(0.99)));
+                    result += buffer;
+                }
+                return result;
+            }
+        };
+        
+        struct Counters {
+            std::atomic<std::uint64_t> num_calls{0};
+            std::atomic<std::uint64_t> total_nanos{0};
+            std::array<std::atomic<std::uint64_t>, num_buckets> histogram{};
+            
+            void record(std::uint64_t nanos) {
+                num_calls.fetch_add(1, std::memory_order_relaxed);
+                total_nanos.fetch_add(nanos, std::memory_order_relaxed);
+                histogram[bucket_of(nanos)].fetch_add(1, std::memory_order_relaxed);
+            }
+            
+            Stats load() const {
+                Stats stats;
+                stats.num_calls = num_calls.load(std::memory_order_relaxed);
+                stats.total_nanos = total_nanos.load(std::memory_order_relaxed);
+                for(std::size_t i = 0; i < num_buckets; ++i) {
+                    stats.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+                }
+                return stats;
+            }
+            
+            void reset() {
+                num_calls.store(0, std::memory_order_relaxed);
+                total_nanos.store(0, std::memory_order_relaxed);
+                for(auto &count : histogram) count.store(0, std::memory_order_relaxed);
+            }
+        };
+        
+        struct Slot {
+            Counters *counters{nullptr};
+        };
+        
+        struct Scope {
+            Scope(Counters *counters)
+            : counters{counters}
+            , begin{clock_type::now()}
+            {}
+            Scope(const Scope &) = delete;
+            ~Scope() {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - begin);
+                counters->record(static_cast<std::uint64_t>(std::max<std::int64_t>(0, elapsed.count())));
+            }
+            Counters *counters;
+            typename clock_type::time_point begin;
+        };
+        
+        Slot slot(const enum_like &value) const {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            auto &counters = state->keys[value];
+            if(!counters) counters.reset(new Counters);
+            return Slot{counters.get()};
+        }
+        
+        Scope begin(const Slot *slot) const
+        { return Scope{slot ? slot->counters : &state->fallback}; }
+        
+        Snapshot snapshot() const {
+            Snapshot snapshot;
+            std::lock_guard<std::mutex> lock(state->mutex);
+            for(const auto &pair : state->keys) snapshot.keys.emplace(pair.first, pair.second->load());
+            snapshot.fallback = state->fallback.load();
+            return snapshot;
+        }
+        
+        void reset() {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            for(auto &pair : state->keys) pair.second->reset();
+            state->fallback.reset();
         }
+    
+    private:
+        struct State {
+            std::mutex mutex;
+            std::map<enum_like, std::unique_ptr<Counters>> keys;
+            Counters fallback;
+        };
         
-        void fallback(std::function<void()> action) {
-            default_action = action;
+        static std::size_t bucket_of(std::uint64_t nanos) {
+            std::size_t bucket = 0;
+#if defined(__GNUC__) || defined(__clang__)
+            if(nanos) bucket = 64 - __builtin_clzll(nanos);
+#else
+            for(; nanos; nanos >>= 1) ++bucket;
+#endif
+            return std::min(bucket, num_buckets - 1);
+        }
+        
+        static std::uint64_t bucket_upper_bound(std::size_t bucket)
+        { return std::uint64_t{1} << bucket; }
+        
+        static std::string key_to_string(const enum_like &value) {
+            if constexpr(std::is_enum<enum_like>::value) {
+                return std::to_string(static_cast<long long>(value));
+            } else if constexpr(std::is_arithmetic<enum_like>::value) {
+                return std::to_string(value);
+            } else {
+                std::ostringstream stream;
+                stream << value;
+                return stream.str();
+            }
+        }
+        
+        std::shared_ptr<State> state{std::make_shared<State>()};
+    };
+    
+    template <
+        typename enum_like,
+        typename signature = void(),
+        std::size_t handler_capacity = 0,
+        typename instrumentation_type = NoSwitchInstrumentation
+    >
+    struct SwitchExecutor;
+    
+    // handlers are called with forwarded arguments.
+    // they are stored in std::function by default. when handler_capacity is not 0, they are stored in
+    // InplaceFunction with buffer of handler_capacity bytes (no allocation per handler, but handler
+    // which captures more than handler_capacity bytes is a compile error).
+    // when no handler is found and fallback isn't set, run() returns result_type{}.
+    //
+    //     ofxSwitchExecutor<MessageType, bool(const Message &)> executor;
+    //     executor.action(MessageType::NoteOn, [this](const Message &m) { ...; return true; });
+    //     bool handled = executor.run(m.type, m);
+    //
+    //     // handlers are stored inline in 32 bytes
+    //     ofxSwitchExecutor<MessageType, bool(const Message &), 32> inline_executor;
+    //
+    // when enum_like is enum or integral and registered values are dense enough,
+    // run() looks up array indexed by value (one bounds check). otherwise, std::map is used.
+    // instrumentation_type is NoSwitchInstrumentation (default) or SwitchInstrumentation<enum_like>.
+    // see also InstrumentedSwitchExecutor.
+    template <
+        typename enum_like,
+        typename result_type,
+        typename ... arguments,
+        std::size_t handler_capacity,
+        typename instrumentation_type
+    >
+    struct SwitchExecutor<enum_like, result_type(arguments ...), handler_capacity, instrumentation_type> {
+        using function_type = typename detail::switch_function<result_type(arguments ...), handler_capacity>::type;
+        
+        SwitchExecutor() = default;
+        // table points into actions, so it is rebuilt for the copy
+        SwitchExecutor(const SwitchExecutor &x)
+        : actions{x.actions}
+        , default_action{x.default_action}
+        , instrumentation{x.instrumentation}
+        , events{x.events}
+        { rebuild_table(); }
+        SwitchExecutor(SwitchExecutor &&) = default;
+        SwitchExecutor &operator=(const SwitchExecutor &x) {
+            if(this == &x) return *this;
+            actions = x.actions;
+            default_action = x.default_action;
+            instrumentation = x.instrumentation;
+            events = x.events;
+            rebuild_table();
+            return *this;
+        }
+        SwitchExecutor &operator=(SwitchExecutor &&) = default;
+        
+        void action(enum_like value, function_type action) {
+            auto it = actions.find(value);
+            if(it != actions.end()) {
+                // same key set, table is still valid
+                it->second.function = std::move(action);
+                return;
+            }
+            actions.emplace(value, Handler{{instrumentation.slot(value)}, std::move(action)});
+            rebuild_table();
+        }
+        
+        void fallback(function_type action) {
+            default_action = std::move(action);
         }
         
         void remove(enum_like value) {
             actions.erase(value);
+            rebuild_table();
         }
         
-        void run(enum_like value) const {
-            if(actions.find(value) != actions.end()) {
-                actions.at(value)();
+        result_type run(enum_like value, arguments ... args) const {
+            const Handler *handler = find(value);
+            [[maybe_unused]] auto scope = instrumentation.begin(handler);
+            if(handler) {
+                return handler->function(std::forward<arguments>(args) ...);
             } else {
-                if(default_action) default_action();
+                if(default_action) return default_action(std::forward<arguments>(args) ...);
+                return result_type();
+            }
+        }
+        
+        // true if run() uses dense table
+        bool isDense() const
+        { return !table.empty(); }
+        
+        const instrumentation_type &getInstrumentation() const
+        { return instrumentation; }
+        instrumentation_type &getInstrumentation()
+        { return instrumentation; }
+        
+        // handlers given to runBatch / flush may call run, runBatch, enqueue and flush of this executor.
+        // nested runBatch / flush use temporary buffers, so they allocate.
+        // action, fallback and remove must not be called from handlers (running handler may be destroyed).
+        
+        // runs handler for each value in [first, last) with same args.
+        // values are grouped by key, so handler is looked up once per group.
+        // groups are run in order of key, not in order of values.
+        // args passed by value are copied into each call but the last one, which gets them moved.
+        // so they must be copyable (move-only arguments can be given to enqueue()).
+        template <typename iterator>
+        void runBatch(iterator first, iterator last, detail::switch_batch_argument<arguments> ... args) {
+            static_assert((... && (std::is_lvalue_reference<arguments>::value
+                                   || std::is_copy_constructible<typename std::decay<arguments>::type>::value)),
+                          "runBatch calls handler many times with same arguments, so arguments passed by value must be copyable. use enqueue() / flush() for move-only arguments");
+            Scratch temporary;
+            scratch_guard guard{batch_scratch, temporary};
+            Scratch &scratch = guard.scratch;
+            scratch.keys.assign(first, last);
+            make_groups(scratch, [&scratch](std::size_t i) { return scratch.keys[i]; }, scratch.keys.size());
+            std::size_t num_left = scratch.keys.size();
+            for(const auto &group : scratch.groups) {
+                const function_type &action = group.handler ? group.handler->function : default_action;
+                for(std::size_t i = group.begin; i < group.end; ++i) {
+                    [[maybe_unused]] auto scope = instrumentation.begin(group.handler);
+                    if(!action) {
+                        --num_left;
+                    } else if(--num_left == 0) {
+                        action(std::forward<detail::switch_batch_argument<arguments>>(args) ...);
+                    } else {
+                        action(copy_argument<arguments>(args) ...);
+                    }
+                }
+            }
+        }
+        
+        template <typename container_type>
+        void runBatch(const container_type &values, detail::switch_batch_argument<arguments> ... args)
+        { runBatch(std::begin(values), std::end(values), std::forward<detail::switch_batch_argument<arguments>>(args) ...); }
+        
+        // stores event with arguments (forwarded and stored by value). flush() moves them into the handler,
+        // so move-only arguments like std::unique_ptr can be queued.
+        template <typename ... argument_types>
+        void enqueue(enum_like value, argument_types && ... args)
+        { events.push_back(Event{value, payload_type(std::forward<argument_types>(args) ...)}); }
+        
+        std::size_t numQueued() const
+        { return events.size(); }
+        
+        // dispatches queued events grouped by key. order of events with same key is kept.
+        // events enqueued by handlers while flushing are dispatched by next flush() (or flush() called by handler).
+        void flush() {
+            Scratch temporary;
+            scratch_guard guard{flush_scratch, temporary};
+            Scratch &scratch = guard.scratch;
+            begin_flush(scratch);
+            for(const auto &group : scratch.groups) run_group(scratch, group);
+            end_flush(scratch);
+        }
+        
+        // same as flush(), but groups which have handler are given to dispatch.
+        // dispatch(num_tasks, task) must call task(i) for each i in [0, num_tasks) (maybe in parallel)
+        // and return after all calls finished. e.g. wrap thread pool of your app.
+        // handlers of different keys may run concurrently, so they may call only run() of this executor.
+        // fallback runs on calling thread after them (same as handlers of flush()).
+        template <
+            typename dispatch_type,
+            typename = typename std::enable_if<!std::is_integral<typename std::decay<dispatch_type>::type>::value>::type
+        >
+        void flushParallel(dispatch_type &&dispatch) {
+            Scratch temporary;
+            scratch_guard guard{flush_scratch, temporary};
+            Scratch &scratch = guard.scratch;
+            begin_flush(scratch);
+            scratch.parallel_groups.clear();
+            for(const auto &group : scratch.groups) if(group.handler) scratch.parallel_groups.push_back(group);
+            if(!scratch.parallel_groups.empty()) {
+                dispatch(scratch.parallel_groups.size(), [this, &scratch](std::size_t i) { run_group(scratch, scratch.parallel_groups[i]); });
+            }
+            for(const auto &group : scratch.groups) if(!group.handler) run_group(scratch, group);
+            end_flush(scratch);
+        }
+        
+        // spawns num_threads - 1 threads per call. for frequent calls, pass dispatch of a thread pool.
+        void flushParallel(std::size_t num_threads) {
+            flushParallel([num_threads](std::size_t num_tasks, const auto &task) {
+                std::atomic<std::size_t> next{0};
+                auto work = [&] {
+                    for(std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < num_tasks;) task(i);
+                };
+                std::vector<std::thread> threads;
+                for(std::size_t i = 1; i < std::min(num_threads, num_tasks); ++i) threads.emplace_back(work);
+                work();
+                for(auto &thread : threads) thread.join();
+            });
+        }
+    
+    private:
+        using payload_type = std::tuple<typename std::decay<arguments>::type ...>;
+        
+        struct Event {
+            enum_like value;
+            payload_type payload;
+        };
+        
+        struct Handler : instrumentation_type::Slot {
+            function_type function;
+        };
+        
+        // events of [begin, end) in Scratch::order have same key. handler == nullptr means fallback.
+        struct Group {
+            const Handler *handler;
+            std::size_t begin;
+            std::size_t end;
+        };
+        
+        // buffers reused by runBatch / flush. each has its own, so handler of flush() can call runBatch().
+        struct Scratch {
+            std::vector<enum_like> keys;
+            std::vector<std::size_t> order;
+            std::vector<Group> groups;
+            std::vector<Group> parallel_groups;
+            std::vector<Event> events;
+            bool is_used{false};
+        };
+        
+        // uses member scratch, or temporary one when member is used by outer call (i.e. called from handler)
+        struct scratch_guard {
+            scratch_guard(Scratch &member, Scratch &temporary)
+            : scratch{member.is_used ? temporary : member}
+            { scratch.is_used = true; }
+            scratch_guard(const scratch_guard &) = delete;
+            ~scratch_guard()
+            { scratch.is_used = false; }
+            Scratch &scratch;
+        };
+        
+        // fills scratch.order with indices grouped by key (stable) and scratch.groups.
+        template <typename key_at_type>
+        void make_groups(Scratch &scratch, key_at_type key_at, std::size_t size) {
+            auto &order = scratch.order;
+            order.resize(size);
+            for(std::size_t i = 0; i < size; ++i) order[i] = i;
+            std::sort(order.begin(), order.end(), [&key_at](std::size_t a, std::size_t b) {
+                const auto &x = key_at(a), &y = key_at(b);
+                return x < y || (!(y < x) && a < b);
+            });
+            scratch.groups.clear();
+            for(std::size_t begin = 0, end; begin < size; begin = end) {
+                const auto &key = key_at(order[begin]);
+                for(end = begin + 1; end < size && !(key < key_at(order[end])); ++end);
+                scratch.groups.push_back(Group{find(key), begin, end});
+            }
+        }
+        
+        void begin_flush(Scratch &scratch) {
+            std::swap(events, scratch.events);
+            make_groups(scratch,
+                        [&scratch](std::size_t i) -> const enum_like & { return scratch.events[i].value; },
+                        scratch.events.size());
+        }
+        
+        void end_flush(Scratch &scratch)
+        { scratch.events.clear(); }
+        
+        void run_group(Scratch &scratch, const Group &group) {
+            const function_type &action = group.handler ? group.handler->function : default_action;
+            for(std::size_t i = group.begin; i < group.end; ++i) {
+                [[maybe_unused]] auto scope = instrumentation.begin(group.handler);
+                if(action) invoke_payload(action, scratch.events[scratch.order[i]].payload, std::index_sequence_for<arguments ...>{});
+            }
+        }
+        
+        // reference as it is, or copy of by-value argument
+        template <typename argument, typename value_type>
+        static decltype(auto) copy_argument(value_type &value) {
+            if constexpr(std::is_lvalue_reference<argument>::value) return (value);
+            else return typename std::decay<argument>::type(value);
+        }
+        
+        // payload is cleared after flush, so by-value arguments are moved from it
+        template <std::size_t ... indices>
+        static void invoke_payload(const function_type &action, payload_type &payload, std::index_sequence<indices ...>)
+        { action(std::forward<arguments>(std::get<indices>(payload)) ...); }
+        
+        using key_traits = detail::switch_key_traits<enum_like>;
+        
+        // table is used when max - min < dense_factor * size + dense_margin
+        static constexpr std::uint64_t dense_factor = 4;
+        static constexpr std::uint64_t dense_margin = 16;
+        
+        const Handler *find(enum_like value) const {
+            if constexpr(key_traits::is_indexable) {
+                if(!table.empty()) {
+                    // values smaller than table_base wrap around and fail the bounds check
+                    const std::uint64_t index = key_traits::to_index(value) - table_base;
+                    return index < table.size() ? table[index] : nullptr;
+                }
+            }
+            auto it = actions.find(value);
+            return it != actions.end() ? &it->second : nullptr;
+        }
+        
+        void rebuild_table() {
+            table.clear();
+            if constexpr(key_traits::is_indexable) {
+                if(actions.empty()) return;
+                const std::uint64_t min = key_traits::to_index(actions.begin()->first);
+                const std::uint64_t max = key_traits::to_index(actions.rbegin()->first);
+                const std::uint64_t range = max - min;
+                if(dense_factor * actions.size() + dense_margin <= range) return;
+                table_base = min;
+                table.assign(range + 1, nullptr);
+                // pointers to std::map's values are stable until they are erased
+                for(const auto &pair : actions) {
+                    table[key_traits::to_index(pair.first) - min] = &pair.second;
+                }
+            }
+        }
+        
+        std::map<enum_like, Handler> actions;
+        std::vector<const Handler *> table;
+        std::uint64_t table_base{0};
+        function_type default_action;
+        instrumentation_type instrumentation;
+        
+        std::vector<Event> events;
+        
+        Scratch batch_scratch;
+        Scratch flush_scratch;
+    };
+    
+    // SwitchExecutor which records per key call counts and latency histograms.
+    //
+    //     ofxInstrumentedSwitchExecutor<Scene> executor;
+    //     ...
+    //     ofLogNotice() << executor.getInstrumentation().snapshot().toString();
+    template <typename enum_like, typename signature = void(), std::size_t handler_capacity = 0>
+    using InstrumentedSwitchExecutor = SwitchExecutor<enum_like, signature, handler_capacity, SwitchInstrumentation<enum_like>>;
+    
+    // SwitchExecutor which can be modified while other threads call run().
+    // handlers are kept in immutable snapshot. action / fallback / remove copy it, modify the copy
+    // and swap pointer (copy on write). run() never locks or waits: it marks itself as reader of
+    // current epoch and calls handler through the snapshot.
+    // writer waits until readers of old snapshots finished (grace period) and deletes them.
+    // waiting is done after write_mutex is released, so handlers on other threads can modify it meanwhile.
+    // when writer is called from handler on same thread, deleting is deferred to next write.
+    template <
+        typename enum_like,
+        typename signature = void(),
+        std::size_t handler_capacity = 0,
+        typename instrumentation_type = NoSwitchInstrumentation
+    >
+    struct ConcurrentSwitchExecutor;
+    
+    template <
+        typename enum_like,
+        typename result_type,
+        typename ... arguments,
+        std::size_t handler_capacity,
+        typename instrumentation_type
+    >
+    struct ConcurrentSwitchExecutor<enum_like, result_type(arguments ...), handler_capacity, instrumentation_type> {
+        using executor_type = SwitchExecutor<enum_like, result_type(arguments ...), handler_capacity, instrumentation_type>;
+        using function_type = typename executor_type::function_type;
+        
+        ConcurrentSwitchExecutor()
+        : current{new executor_type}
+        {}
+        
+        ConcurrentSwitchExecutor(const ConcurrentSwitchExecutor &) = delete;
+        ConcurrentSwitchExecutor &operator=(const ConcurrentSwitchExecutor &) = delete;
+        
+        // no reader may be running
+        ~ConcurrentSwitchExecutor() {
+            delete current.load();
+            for(auto retired_executor : retired) delete retired_executor;
+        }
+        
+        void action(enum_like value, function_type action)
+        { update([&](executor_type &executor) { executor.action(value, std::move(action)); }); }
+        
+        void fallback(function_type action)
+        { update([&](executor_type &executor) { executor.fallback(std::move(action)); }); }
+        
+        void remove(enum_like value)
+        { update([&](executor_type &executor) { executor.remove(value); }); }
+        
+        // applies several modifications with one copy and swap.
+        template <typename modifier_type>
+        void update(modifier_type modifier) {
+            std::vector<executor_type *> retired_executors;
+            {
+                std::lock_guard<std::mutex> lock(write_mutex);
+                auto next = new executor_type(*current.load());
+                modifier(*next);
+                retired.push_back(current.exchange(next));
+                ++num_updates;
+                if(0 < read_depth()) return;
+                retired_executors.swap(retired);
             }
+            std::lock_guard<std::mutex> lock(synchronize_mutex);
+            synchronize();
+            for(auto retired_executor : retired_executors) delete retired_executor;
+        }
+        
+        result_type run(enum_like value, arguments ... args) const {
+            read_guard guard{*this};
+            return current.load()->run(value, std::forward<arguments>(args) ...);
+        }
+        
+        bool isDense() const {
+            read_guard guard{*this};
+            return current.load()->isDense();
+        }
+        
+        // counters of SwitchInstrumentation are shared by all snapshots
+        instrumentation_type getInstrumentation() const {
+            read_guard guard{*this};
+            return current.load()->getInstrumentation();
+        }
+        
+        std::uint64_t numUpdates() const {
+            std::lock_guard<std::mutex> lock(write_mutex);
+            return num_updates;
         }
         
+        // snapshots replaced but not deleted yet (deferred by writes from handlers)
+        std::size_t numRetired() const {
+            std::lock_guard<std::mutex> lock(write_mutex);
+            return retired.size();
+        }
+    
     private:
-        std::map<enum_like, std::function<void()>> actions;
-        std::function<void()> default_action;
+        struct alignas(64) reader_counter {
+            std::atomic<std::size_t> count{0};
+        };
+        
+        struct read_guard {
+            read_guard(const ConcurrentSwitchExecutor &executor)
+            : counter{executor.readers[executor.epoch.load() & 1].count}
+            {
+                counter.fetch_add(1);
+                ++read_depth();
+            }
+            ~read_guard() {
+                --read_depth();
+                counter.fetch_sub(1);
+            }
+            std::atomic<std::size_t> &counter;
+        };
+        
+        // depth of run() on this thread (shared by all executors of same type, only used to avoid self-wait)
+        static std::size_t &read_depth() {
+            thread_local std::size_t depth = 0;
+            return depth;
+        }
+        
+        // after two flips of epoch, every reader which may see retired snapshots has finished.
+        // called with synchronize_mutex, not write_mutex (readers may wait for write_mutex).
+        void synchronize() {
+            for(int i = 0; i < 2; ++i) {
+                const std::size_t old_epoch = epoch.fetch_add(1) & 1;
+                while(readers[old_epoch].count.load() != 0) std::this_thread::yield();
+            }
+        }
+        
+        std::atomic<executor_type *> current;
+        std::atomic<std::size_t> epoch{0};
+        mutable reader_counter readers[2];
+        mutable std::mutex write_mutex;
+        std::mutex synchronize_mutex;
+        std::vector<executor_type *> retired;
+        std::uint64_t num_updates{0};
+    };
+    
+    namespace detail {
+        struct no_switch_action {
+            constexpr void operator()() const {}
+        };
+        
+        template <typename enum_like, enum_like value>
+        using no_switch_action_for = no_switch_action;
+        
+        template <typename enum_like, enum_like target, enum_like ... values>
+        constexpr std::size_t index_of_value() {
+            constexpr bool matches[] = { (values == target) ..., false };
+            for(std::size_t i = 0; i < sizeof...(values); ++i) if(matches[i]) return i;
+            return sizeof...(values);
+        }
     };
+    
+    // SwitchExecutor with values and handlers known at compile time.
+    // handlers are stored by value in std::tuple, so there is no type erasure or allocation
+    // and they can be inlined into run().
+    // action / fallback return new executor which has the given handler.
+    //
+    //     constexpr auto executor = ofxStaticSwitchExecutor<Mode, Mode::A, Mode::B, Mode::C>{}
+    //         .action<Mode::A>([] { ... })
+    //         .action<Mode::B>([] { ... })
+    //         .fallback([] { ... });
+    //     executor.run(mode);
+    template <typename enum_like, typename actions_tuple, typename fallback_type, enum_like ... values>
+    struct BasicStaticSwitchExecutor {
+        static_assert(sizeof...(values) == std::tuple_size<actions_tuple>::value,
+                      "number of actions must be same as number of values");
+        
+        constexpr BasicStaticSwitchExecutor() = default;
+        constexpr BasicStaticSwitchExecutor(actions_tuple actions, fallback_type default_action)
+        : actions(std::move(actions))
+        , default_action(std::move(default_action))
+        {}
+        
+        template <enum_like value, typename action_type>
+        constexpr auto action(action_type action) const {
+            constexpr std::size_t index = detail::index_of_value<enum_like, value, values ...>();
+            static_assert(index < sizeof...(values), "value is not in the value list");
+            auto new_actions = replace_action<index>(std::move(action), std::make_index_sequence<sizeof...(values)>{});
+            return BasicStaticSwitchExecutor<enum_like, decltype(new_actions), fallback_type, values ...>{std::move(new_actions), default_action};
+        }
+        
+        template <typename action_type>
+        constexpr auto fallback(action_type action) const {
+            return BasicStaticSwitchExecutor<enum_like, actions_tuple, action_type, values ...>{actions, std::move(action)};
+        }
+        
+        constexpr void run(enum_like value) const {
+            run_impl(value, std::make_index_sequence<sizeof...(values)>{});
+        }
+    
+    private:
+        template <std::size_t index, typename action_type, std::size_t ... indices>
+        constexpr auto replace_action(action_type &&action, std::index_sequence<indices ...>) const {
+            return std::make_tuple(select_action<index, indices>(std::forward<action_type>(action)) ...);
+        }
+        
+        template <std::size_t index, std::size_t i, typename action_type>
+        constexpr decltype(auto) select_action(action_type &&action) const {
+            if constexpr(index == i) return std::forward<action_type>(action);
+            else return std::get<i>(actions);
+        }
+        
+        // compilers lower this chain of comparisons of constants to a jump table like switch
+        template <std::size_t ... indices>
+        constexpr void run_impl(enum_like value, std::index_sequence<indices ...>) const {
+            static_cast<void>(value); // unused when values is empty
+            bool is_matched = ((value == values ? (invoke<indices>(), true) : false) || ...);
+            if(!is_matched) default_action();
+        }
+        
+        template <std::size_t index>
+        constexpr void invoke() const {
+            using action_type = typename std::tuple_element<index, actions_tuple>::type;
+            if constexpr(std::is_same<action_type, detail::no_switch_action>::value) default_action();
+            else std::get<index>(actions)();
+        }
+        
+        actions_tuple actions;
+        fallback_type default_action;
+    };
+    
+    template <typename enum_like, enum_like ... values>
+    using StaticSwitchExecutor = BasicStaticSwitchExecutor<
+        enum_like,
+        std::tuple<detail::no_switch_action_for<enum_like, values> ...>,
+        detail::no_switch_action,
+        values ...
+    >;
 };
 
-template <typename enum_like>
-using ofxSwitchExecutor = ofx::SwitchExecutor<enum_like>;
+template <
+    typename enum_like,
+    typename signature = void(),
+    std::size_t handler_capacity = 0,
+    typename instrumentation_type = ofx::NoSwitchInstrumentation
+>
+using ofxSwitchExecutor = ofx::SwitchExecutor<enum_like, signature, handler_capacity, instrumentation_type>;
+
+template <typename enum_like, typename signature = void(), std::size_t handler_capacity = 0>
+using ofxInstrumentedSwitchExecutor = ofx::InstrumentedSwitchExecutor<enum_like, signature, handler_capacity>;
+
+template <
+    typename enum_like,
+    typename signature = void(),
+    std::size_t handler_capacity = 0,
+    typename instrumentation_type = ofx::NoSwitchInstrumentation
+>
+using ofxConcurrentSwitchExecutor = ofx::ConcurrentSwitchExecutor<enum_like, signature, handler_capacity, instrumentation_type>;
+
+template <typename enum_like, typename clock_type = std::chrono::steady_clock>
+using ofxSwitchInstrumentation = ofx::SwitchInstrumentation<enum_like, clock_type>;
+
+template <typename enum_like, enum_like ... values>
+using ofxStaticSwitchExecutor = ofx::StaticSwitchExecutor<enum_like, values ...>;
 
 #endif /* ofxSwitchExecutor_h */
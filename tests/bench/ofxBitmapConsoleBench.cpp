@@ -0,0 +1,143 @@
+//
+//  ofxBitmapConsoleBench.cpp
+//
+
+#include "ofxBitmapConsole.h"
+
+#include "RegexFold.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+    struct FoldableConsole : ofx::BitmapConsole {
+        using ofx::BitmapConsole::fold;
+    };
+
+    std::vector<std::string> makeLines(std::size_t num_lines, std::size_t num_words) {
+        static const char *words[] = {"update", "frame", "texture", "id:", "42,", "ok.", "-", "shader", "compiled", "in", "0.3ms"};
+        std::vector<std::string> lines(num_lines);
+        std::size_t n = 0;
+        for(auto &line : lines) {
+            for(std::size_t i = 0; i < num_words; ++i) {
+                if(i) line += ' ';
+                line += words[n++ % (sizeof(words) / sizeof(words[0]))];
+            }
+        }
+        return lines;
+    }
+};
+
+// add into growable console (no eviction)
+static void BM_ConsoleAdd(benchmark::State &state) {
+    const auto lines = makeLines(256, 8);
+    ofxBitmapConsole console;
+    std::size_t i = 0;
+    for(auto _ : state) {
+        if(i % 65536 == 0) {
+            state.PauseTiming();
+            console.setup();
+            state.ResumeTiming();
+        }
+        console.add(lines[i++ % lines.size()]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConsoleAdd);
+
+// add into full console, every add evicts the oldest entry
+static void BM_ConsoleAddEvict(benchmark::State &state) {
+    const auto lines = makeLines(256, 8);
+    ofxBitmapConsole console;
+    auto settings = ofxBitmapConsole::Settings().maxLines(state.range(0));
+    if(state.range(1)) settings.fixedCapacity(state.range(0)).arenaChunkSize(4096);
+    console.setup(settings);
+    for(std::int64_t i = 0; i < state.range(0); ++i) console.add(lines[i % lines.size()]);
+    std::size_t i = 0;
+    for(auto _ : state) console.add(lines[i++ % lines.size()]);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConsoleAddEvict)
+    ->ArgNames({"max_lines", "fixed"})
+    ->Args({100, 0})->Args({100, 1})
+    ->Args({10000, 0})->Args({10000, 1});
+
+// add with Settings::numFold
+static void BM_ConsoleAddFold(benchmark::State &state) {
+    const auto lines = makeLines(256, state.range(0));
+    ofxBitmapConsole console;
+    console.setup(ofxBitmapConsole::Settings().maxLines(1000).numFold(40));
+    std::size_t i = 0;
+    for(auto _ : state) console.add(lines[i++ % lines.size()]);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConsoleAddFold)->ArgName("words")->Arg(4)->Arg(64);
+
+static void BM_ConsoleFold(benchmark::State &state) {
+    const auto lines = makeLines(64, state.range(0));
+    std::string output;
+    std::size_t bytes = 0, i = 0;
+    for(auto _ : state) {
+        const auto &line = lines[i++ % lines.size()];
+        FoldableConsole::fold(line, 40, output);
+        benchmark::DoNotOptimize(output.data());
+        bytes += line.size();
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ConsoleFold)->ArgName("words")->Arg(4)->Arg(64)->Arg(1024);
+
+// baseline: fold before single pass rewrite (regex split + string concatenation)
+static void BM_ConsoleRegexFold(benchmark::State &state) {
+    const auto lines = makeLines(64, state.range(0));
+    std::size_t bytes = 0, i = 0;
+    for(auto _ : state) {
+        const auto &line = lines[i++ % lines.size()];
+        auto output = ofStub::regexFold(line, 40);
+        benchmark::DoNotOptimize(output.data());
+        bytes += line.size();
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ConsoleRegexFold)->ArgName("words")->Arg(4)->Arg(64)->Arg(1024);
+
+// post from producer thread(s) and drain by update() on thread 0
+static void BM_ConsolePost(benchmark::State &state) {
+    static ofxBitmapConsole console;
+    if(state.thread_index() == 0) console.setup(ofxBitmapConsole::Settings().maxLines(1000).queueCapacity(4096));
+    const std::string line = "posted from worker thread";
+    for(auto _ : state) {
+        console.post(line);
+        if(state.thread_index() == 0) console.update();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConsolePost)->Threads(1)->Threads(4);
+
+static void BM_ConsoleBuildMesh(benchmark::State &state) {
+    const auto lines = makeLines(256, 8);
+    ofxBitmapConsole console;
+    console.setup(ofxBitmapConsole::Settings().maxLines(state.range(0)));
+    for(std::int64_t i = 0; i < state.range(0); ++i) console.add(lines[i % lines.size()]);
+    ofMesh glyphs, backgrounds;
+    for(auto _ : state) {
+        console.buildMesh(0.0f, 0.0f, 768.0f, glyphs, backgrounds);
+        benchmark::DoNotOptimize(glyphs.getNumVertices());
+    }
+}
+BENCHMARK(BM_ConsoleBuildMesh)->ArgName("lines")->Arg(100)->Arg(100000);
+
+// scroll to the middle of long history and find first visible entry
+static void BM_ConsoleScroll(benchmark::State &state) {
+    ofxBitmapConsole console;
+    console.setup();
+    for(int i = 0; i < 100000; ++i) console.add(i % 3 ? "line" : "two\nlines");
+    std::size_t offset = 0;
+    for(auto _ : state) {
+        console.scrollTo(offset = (offset + 7919) % console.numLines());
+        benchmark::DoNotOptimize(console.firstVisibleEntry());
+    }
+}
+BENCHMARK(BM_ConsoleScroll);
@@ -0,0 +1,85 @@
+//
+//  ofxCrossFadeBench.cpp
+//
+//  update / draw bookkeeping of fades. draws go to CountingDraws, time comes from offline ofxClock.
+//
+
+// ofxCrossFade.h expects ofSetColor declared by ofMain.h
+#include "ofGraphics.h"
+#include "ofxCrossFade.h"
+#include "ofxCrossFadeScheduler.h"
+
+#include "CountingDraws.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+    struct OfflineClock {
+        OfflineClock()
+        { ofxClock::shared().setOffline(1.0 / 60.0); }
+        ~OfflineClock()
+        { ofxClock::shared().setRealtime(); }
+    };
+};
+
+// N fades as std::shared_ptr<CrossFade>, restarted when completed
+static void BM_CrossFadeUpdateDraw(benchmark::State &state) {
+    OfflineClock clock;
+    const std::size_t num_fades = state.range(0);
+    ofStub::CountingDraws from, to;
+    std::vector<ofxCrossFade::Ref> fades(num_fades);
+    for(auto _ : state) {
+        for(auto &fade : fades) {
+            if(!fade) fade = ofxCrossFade::create(from, to, 0.5f);
+            update(fade);
+            if(fade) fade->draw(0, 0, 64, 64);
+        }
+        ofxClock::shared().advance();
+    }
+    state.SetItemsProcessed(state.iterations() * num_fades);
+    state.counters["draws"] = benchmark::Counter(static_cast<double>(to.num_draws), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_CrossFadeUpdateDraw)->ArgName("fades")->Arg(16)->Arg(1024);
+
+// same with CrossFadeScheduler
+static void BM_CrossFadeSchedulerUpdateDraw(benchmark::State &state) {
+    OfflineClock clock;
+    const std::size_t num_fades = state.range(0);
+    ofStub::CountingDraws from, to;
+    ofxCrossFadeScheduler scheduler;
+    scheduler.reserve(num_fades);
+    std::vector<ofxCrossFadeScheduler::Handle> handles(num_fades);
+    for(auto _ : state) {
+        for(auto &handle : handles) {
+            if(!scheduler.isActive(handle)) handle = scheduler.start(from, to, 0.5f);
+        }
+        scheduler.update();
+        for(const auto &handle : handles) scheduler.draw(handle, 0, 0, 64, 64);
+        ofxClock::shared().advance();
+    }
+    state.SetItemsProcessed(state.iterations() * num_fades);
+    state.counters["draws"] = benchmark::Counter(static_cast<double>(to.num_draws), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_CrossFadeSchedulerUpdateDraw)->ArgName("fades")->Arg(16)->Arg(1024);
+
+// VideoFader::update with synthetic players
+static void BM_VideoFaderUpdate(benchmark::State &state) {
+    OfflineClock clock;
+    ofVideoPlayer from, to;
+    from.getPixels().allocate(320, 180, 3);
+    to.getPixels().allocate(320, 180, 3);
+    const auto settings = ofxVideoFader::Settings().preroll(state.range(0));
+    ofxVideoFader::Ref fader;
+    for(auto _ : state) {
+        if(!fader) {
+            from.play();
+            fader = ofxVideoFader::create(from, to, 1.0f, settings);
+        }
+        if(fader->update()) fader.reset();
+        ofxClock::shared().advance();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VideoFaderUpdate)->ArgName("preroll")->Arg(0)->Arg(4);
@@ -0,0 +1,92 @@
+//
+//  ofxCrossFadePixelsBench.cpp
+//
+//  blend of 1920x1080 RGBA pixels. megapixels counter is rate (Mpx/s).
+//
+
+#include "ofxCrossFadePixels.h"
+
+#include "TaskPool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+    constexpr std::size_t width = 1920;
+    constexpr std::size_t height = 1080;
+    constexpr std::size_t num_channels = 4;
+
+    template <typename pixels_type>
+    void fill(pixels_type &pixels, std::uint32_t seed) {
+        using value_type = typename std::decay<decltype(pixels[0])>::type;
+        const float scale = std::is_floating_point<value_type>::value ? 1.0f / 255.0f : 1.0f;
+        pixels.allocate(width, height, num_channels);
+        for(std::size_t i = 0; i < pixels.size(); ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            pixels[i] = static_cast<value_type>((seed >> 24) * scale);
+        }
+    }
+
+    void setCounters(benchmark::State &state) {
+        state.counters["megapixels"] = benchmark::Counter(state.iterations() * width * height / 1e6,
+                                                          benchmark::Counter::kIsRate);
+        state.SetBytesProcessed(state.iterations() * width * height * num_channels);
+    }
+};
+
+// ofPixels (8bit) / ofFloatPixels with num_threads given by arg. spawns threads per blend
+template <typename pixels_type>
+static void BM_CrossFadePixels(benchmark::State &state) {
+    pixels_type from, to, dst;
+    fill(from, 1);
+    fill(to, 2);
+    float alpha = 0.0f;
+    for(auto _ : state) {
+        ofxCrossFadePixels::blend(from, to, alpha, dst, state.range(0));
+        benchmark::DoNotOptimize(dst.getData());
+        alpha = alpha < 1.0f ? alpha + 1.0f / 64.0f : 0.0f;
+    }
+    setCounters(state);
+    state.SetLabel(ofxCrossFadePixels::kernelName());
+}
+BENCHMARK_TEMPLATE(BM_CrossFadePixels, ofPixels)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CrossFadePixels, ofFloatPixels)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+// same with persistent TaskPool of num_threads given by arg (dispatch hook)
+template <typename pixels_type>
+static void BM_CrossFadePixelsPool(benchmark::State &state) {
+    pixels_type from, to, dst;
+    fill(from, 1);
+    fill(to, 2);
+    TaskPool pool(state.range(0));
+    float alpha = 0.0f;
+    for(auto _ : state) {
+        ofxCrossFadePixels::blend(from, to, alpha, dst, state.range(0), pool);
+        benchmark::DoNotOptimize(dst.getData());
+        alpha = alpha < 1.0f ? alpha + 1.0f / 64.0f : 0.0f;
+    }
+    setCounters(state);
+    state.SetLabel(ofxCrossFadePixels::kernelName());
+}
+BENCHMARK_TEMPLATE(BM_CrossFadePixelsPool, ofPixels)->ArgName("threads")->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CrossFadePixelsPool, ofFloatPixels)->ArgName("threads")->Arg(2)->Arg(4)->UseRealTime();
+
+// baseline: per channel float lerp of 8bit pixels on one thread
+static void BM_CrossFadePixelsNaive(benchmark::State &state) {
+    ofPixels from, to, dst;
+    fill(from, 1);
+    fill(to, 2);
+    dst.allocate(width, height, num_channels);
+    float alpha = 0.0f;
+    for(auto _ : state) {
+        for(std::size_t i = 0; i < dst.size(); ++i) {
+            dst[i] = static_cast<unsigned char>(from[i] * (1.0f - alpha) + to[i] * alpha + 0.5f);
+        }
+        benchmark::DoNotOptimize(dst.getData());
+        alpha = alpha < 1.0f ? alpha + 1.0f / 64.0f : 0.0f;
+    }
+    setCounters(state);
+}
+BENCHMARK(BM_CrossFadePixelsNaive)->UseRealTime();
@@ -0,0 +1,76 @@
+//
+//  ofxFboReadbackBench.cpp
+//
+//  one frame = clear fbo + readback. needs headless GL context (see HeadlessGL.h). skipped without it.
+//  on software GL (llvmpipe) "GPU" work runs on CPU, so async gain is smaller than on real GPU.
+//
+
+#include "ofGraphics.h"
+#include "ofxFboReadback.h"
+
+#include "HeadlessGL.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+    void drawFrame(ofFbo &fbo, std::int64_t frame) {
+        fbo.begin();
+        ofClear(frame % 256, 0, 0, 255);
+        fbo.end();
+    }
+
+    void setFrameCounters(benchmark::State &state, std::int64_t width, std::int64_t height) {
+        state.counters["fps"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+        state.SetBytesProcessed(state.iterations() * width * height * 4);
+    }
+};
+
+// baseline: synchronous ofFbo::readToPixels every frame
+static void BM_FboReadToPixels(benchmark::State &state) {
+    if(!ofStub::ensureHeadlessGL()) {
+        state.SkipWithError(ofStub::headlessGLDescription().c_str());
+        return;
+    }
+    ofFbo fbo;
+    fbo.allocate(state.range(0), state.range(1), GL_RGBA8);
+    ofPixels pixels;
+    std::int64_t frame = 0;
+    for(auto _ : state) {
+        drawFrame(fbo, frame++);
+        fbo.readToPixels(pixels);
+        benchmark::DoNotOptimize(pixels.getData());
+    }
+    setFrameCounters(state, state.range(0), state.range(1));
+}
+BENCHMARK(BM_FboReadToPixels)->ArgNames({"width", "height"})->Args({256, 256})->Args({1920, 1080})->UseRealTime();
+
+// FboReadbackRing with N buffers: queue and poll every frame, drain at end.
+// latency is in frames, dropped is ratio of queue() which found no free buffer.
+static void BM_FboReadbackRing(benchmark::State &state) {
+    if(!ofStub::ensureHeadlessGL()) {
+        state.SkipWithError(ofStub::headlessGLDescription().c_str());
+        return;
+    }
+    ofFbo fbo;
+    fbo.allocate(state.range(0), state.range(1), GL_RGBA8);
+    ofxFboReadbackRing readback;
+    readback.setup(state.range(2));
+    ofPixels pixels;
+    std::int64_t frame = 0;
+    for(auto _ : state) {
+        drawFrame(fbo, frame++);
+        readback.queue(fbo);
+        if(readback.poll(pixels)) benchmark::DoNotOptimize(pixels.getData());
+    }
+    while(readback.wait(pixels)) benchmark::DoNotOptimize(pixels.getData());
+    setFrameCounters(state, state.range(0), state.range(1));
+    const auto &stats = readback.getStats();
+    state.counters["latency"] = stats.averageLatency();
+    state.counters["max_latency"] = static_cast<double>(stats.max_latency);
+    state.counters["dropped"] = stats.num_queued ? static_cast<double>(stats.num_dropped) / stats.num_queued : 0.0;
+}
+BENCHMARK(BM_FboReadbackRing)
+    ->ArgNames({"width", "height", "buffers"})
+    ->ArgsProduct({{256}, {256}, {2, 3}})
+    ->ArgsProduct({{1920}, {1080}, {2, 3, 4}})
+    ->UseRealTime();
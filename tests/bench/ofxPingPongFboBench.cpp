@@ -0,0 +1,78 @@
+//
+//  ofxPingPongFboBench.cpp
+//
+//  needs headless GL context (see HeadlessGL.h). skipped without it.
+//
+
+#include "ofxPingPongFbo.h"
+
+#include "HeadlessGL.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+    ofFboSettings makeSettings(int width, int height) {
+        ofFboSettings settings;
+        settings.width = width;
+        settings.height = height;
+        settings.internalformat = GL_RGBA8;
+        return settings;
+    }
+};
+
+// next() / operator[] / prevFbo() on fbos which are already leased
+static void BM_PingPongIndexMath(benchmark::State &state) {
+    if(!ofStub::ensureHeadlessGL()) {
+        state.SkipWithError(ofStub::headlessGLDescription().c_str());
+        return;
+    }
+    ofx::FboPool pool;
+    ofxPingPongFbo fbo;
+    fbo.allocate(makeSettings(4, 4), state.range(0), pool);
+    for(std::size_t i = 0; i < fbo.size(); ++i) fbo.prevFbo(i);
+    std::int64_t n = 0;
+    for(auto _ : state) {
+        fbo.next();
+        benchmark::DoNotOptimize(&fbo[-1]);
+        benchmark::DoNotOptimize(&fbo.prevFbo(++n));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PingPongIndexMath)->ArgName("fbos")->Arg(2)->Arg(8);
+
+// lease and give back one fbo, i.e. cost of PingPongFbo::release() + first begin()
+static void BM_FboPoolLease(benchmark::State &state) {
+    if(!ofStub::ensureHeadlessGL()) {
+        state.SkipWithError(ofStub::headlessGLDescription().c_str());
+        return;
+    }
+    ofx::FboPool pool;
+    const auto settings = makeSettings(state.range(0), state.range(0));
+    for(auto _ : state) {
+        auto lease = pool.lease(settings);
+        benchmark::DoNotOptimize(lease.get());
+    }
+    glFinish();
+    state.counters["allocations"] = static_cast<double>(pool.getStats().num_allocations);
+}
+BENCHMARK(BM_FboPoolLease)->ArgName("size")->Arg(64)->Arg(1024);
+
+// ping-pong step: begin, clear, end with next
+static void BM_PingPongStep(benchmark::State &state) {
+    if(!ofStub::ensureHeadlessGL()) {
+        state.SkipWithError(ofStub::headlessGLDescription().c_str());
+        return;
+    }
+    ofx::FboPool pool;
+    ofxPingPongFbo fbo;
+    fbo.allocate(makeSettings(state.range(0), state.range(0)), 2, pool);
+    fbo.setAutomaticallyNextWithEnd(true);
+    for(auto _ : state) {
+        fbo.begin();
+        ofClear(0, 0, 0, 0);
+        fbo.end();
+    }
+    glFinish();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PingPongStep)->ArgName("size")->Arg(256);
@@ -0,0 +1,137 @@
+//
+//  ofxSwitchExecutorBench.cpp
+//
+
+#include "ofxSwitchExecutor.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+    // random keys in [0, num_keys) with some misses (fallback)
+    std::vector<int> makeKeys(int num_keys, std::size_t size = 4096) {
+        std::mt19937 random{42};
+        std::uniform_int_distribution<int> distribution{0, num_keys + num_keys / 8};
+        std::vector<int> keys(size);
+        for(auto &key : keys) key = distribution(random);
+        return keys;
+    }
+    
+    // spreads keys so registered values are too sparse for dense table
+    constexpr int sparse_stride = 1000;
+};
+
+static void BM_ExecutorRun(benchmark::State &state) {
+    const int num_keys = static_cast<int>(state.range(0));
+    ofxSwitchExecutor<int, void(std::uint64_t &)> executor;
+    for(int key = 0; key < num_keys; ++key) executor.action(key, [key](std::uint64_t &sum) { sum += key; });
+    executor.fallback([](std::uint64_t &sum) { ++sum; });
+    const auto keys = makeKeys(num_keys);
+    std::uint64_t sum = 0;
+    std::size_t i = 0;
+    for(auto _ : state) {
+        executor.run(keys[i++ & 4095], sum);
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecutorRun)->ArgName("keys")->Arg(8)->Arg(64)->Arg(1024);
+
+// same as BM_ExecutorRun with dense table (layout:0) or with map when keys are sparse (layout:1)
+static void BM_ExecutorLookup(benchmark::State &state) {
+    const int num_keys = static_cast<int>(state.range(0));
+    const int stride = state.range(1) ? sparse_stride : 1;
+    ofxSwitchExecutor<int, void(std::uint64_t &)> executor;
+    for(int key = 0; key < num_keys; ++key) executor.action(key * stride, [key](std::uint64_t &sum) { sum += key; });
+    executor.fallback([](std::uint64_t &sum) { ++sum; });
+    if(executor.isDense() != (stride == 1)) {
+        state.SkipWithError("unexpected table layout");
+        return;
+    }
+    auto keys = makeKeys(num_keys);
+    for(auto &key : keys) key *= stride;
+    std::uint64_t sum = 0;
+    std::size_t i = 0;
+    for(auto _ : state) {
+        executor.run(keys[i++ & 4095], sum);
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecutorLookup)->ArgNames({"keys", "layout"})->ArgsProduct({{8, 64, 1024}, {0, 1}});
+
+// baseline: SwitchExecutor before dense table (std::map of std::function, find then at)
+static void BM_MapFunctionLookup(benchmark::State &state) {
+    const int num_keys = static_cast<int>(state.range(0));
+    const int stride = state.range(1) ? sparse_stride : 1;
+    std::map<int, std::function<void(std::uint64_t &)>> actions;
+    for(int key = 0; key < num_keys; ++key) actions[key * stride] = [key](std::uint64_t &sum) { sum += key; };
+    const std::function<void(std::uint64_t &)> default_action = [](std::uint64_t &sum) { ++sum; };
+    auto keys = makeKeys(num_keys);
+    for(auto &key : keys) key *= stride;
+    std::uint64_t sum = 0;
+    std::size_t i = 0;
+    for(auto _ : state) {
+        const int key = keys[i++ & 4095];
+        if(actions.find(key) != actions.end()) actions.at(key)(sum);
+        else default_action(sum);
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MapFunctionLookup)->ArgNames({"keys", "layout"})->ArgsProduct({{8, 64, 1024}, {0, 1}});
+
+static void BM_ExecutorRunBatch(benchmark::State &state) {
+    const int num_keys = static_cast<int>(state.range(0));
+    ofxSwitchExecutor<int, void(std::uint64_t &)> executor;
+    for(int key = 0; key < num_keys; ++key) executor.action(key, [key](std::uint64_t &sum) { sum += key; });
+    const auto keys = makeKeys(num_keys, 256);
+    std::uint64_t sum = 0;
+    for(auto _ : state) {
+        executor.runBatch(keys, sum);
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_ExecutorRunBatch)->ArgName("keys")->Arg(8)->Arg(1024);
+
+static void BM_ExecutorEnqueueFlush(benchmark::State &state) {
+    ofxSwitchExecutor<int, void(int)> executor;
+    std::uint64_t sum = 0;
+    for(int key = 0; key < 16; ++key) executor.action(key, [&sum](int x) { sum += x; });
+    const auto keys = makeKeys(16, 256);
+    for(auto _ : state) {
+        for(auto key : keys) executor.enqueue(key, key);
+        executor.flush();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_ExecutorEnqueueFlush);
+
+// run() on every benchmark thread while thread 0 also replaces a handler every 1024 iterations
+static void BM_ConcurrentExecutorRun(benchmark::State &state) {
+    static ofxConcurrentSwitchExecutor<int, int(int)> executor;
+    if(state.thread_index() == 0) {
+        for(int key = 0; key < 64; ++key) executor.action(key, [key](int x) { return x + key; });
+    }
+    const auto keys = makeKeys(64);
+    std::size_t i = 0;
+    int sum = 0;
+    for(auto _ : state) {
+        sum += executor.run(keys[i & 4095], 1);
+        if(state.thread_index() == 0 && ++i % 1024 == 0) {
+            executor.action(static_cast<int>(i % 64), [](int x) { return x; });
+        } else {
+            ++i;
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConcurrentExecutorRun)->Threads(1)->Threads(4);
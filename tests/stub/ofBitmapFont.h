@@ -0,0 +1,55 @@
+//
+//  ofBitmapFont.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  getMesh() makes 6 vertices per glyph like openFrameworks (8x13 px cells, 20 px line height is up to caller).
+//
+
+#pragma once
+
+#include "ofMesh.h"
+#include "ofTexture.h"
+
+#include <string>
+
+enum ofDrawBitmapMode {
+    OF_BITMAPMODE_SIMPLE = 0,
+    OF_BITMAPMODE_SCREEN
+};
+
+class ofBitmapFont {
+public:
+    const ofMesh &getMesh(const std::string &text, int x, int y, ofDrawBitmapMode = OF_BITMAPMODE_SIMPLE, bool = true) const {
+        mesh.clear();
+        float left = static_cast<float>(x);
+        float top = static_cast<float>(y);
+        for(char c : text) {
+            if(c == '\n') {
+                left = static_cast<float>(x);
+                top += 13.0f;
+                continue;
+            }
+            const float u = static_cast<float>(static_cast<unsigned char>(c) % 16) / 16.0f;
+            const float v = static_cast<float>(static_cast<unsigned char>(c) / 16) / 16.0f;
+            const float s = 1.0f / 16.0f;
+            mesh.addVertex({left, top - 10.0f, 0.0f});
+            mesh.addVertex({left + 8.0f, top - 10.0f, 0.0f});
+            mesh.addVertex({left + 8.0f, top + 3.0f, 0.0f});
+            mesh.addVertex({left + 8.0f, top + 3.0f, 0.0f});
+            mesh.addVertex({left, top + 3.0f, 0.0f});
+            mesh.addVertex({left, top - 10.0f, 0.0f});
+            mesh.getTexCoords().insert(mesh.getTexCoords().end(), {
+                {u, v}, {u + s, v}, {u + s, v + s}, {u + s, v + s}, {u, v + s}, {u, v}
+            });
+            left += 8.0f;
+        }
+        return mesh;
+    }
+
+    const ofTexture &getTexture() const
+    { return texture; }
+
+protected:
+    mutable ofMesh mesh;
+    ofTexture texture;
+};
@@ -0,0 +1,66 @@
+//
+//  ofBufferObject.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  copies share the GL buffer like openFrameworks.
+//
+
+#pragma once
+
+#include "ofGLBaseTypes.h"
+
+#include <cstddef>
+#include <memory>
+
+class ofBufferObject {
+public:
+    void allocate(std::size_t bytes, GLenum usage) {
+        if(!data) {
+            GLuint id = 0;
+            glGenBuffers(1, &id);
+            data = std::shared_ptr<Data>(new Data{id, 0}, [](Data *data) {
+                glDeleteBuffers(1, &data->id);
+                delete data;
+            });
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, data->id);
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, usage);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        data->size = bytes;
+    }
+
+    bool isAllocated() const
+    { return data && data->size; }
+    std::size_t size() const
+    { return data ? data->size : 0; }
+    GLuint getId() const
+    { return data ? data->id : 0; }
+
+    void bind(GLenum target) const
+    { glBindBuffer(target, getId()); }
+    void unbind(GLenum target) const
+    { glBindBuffer(target, 0); }
+
+    void *map(GLenum access) {
+        glBindBuffer(GL_COPY_READ_BUFFER, getId());
+        void *ptr = glMapBuffer(GL_COPY_READ_BUFFER, access);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        return ptr;
+    }
+    template <typename value_type>
+    value_type *map(GLenum access)
+    { return static_cast<value_type *>(map(access)); }
+
+    void unmap() {
+        glBindBuffer(GL_COPY_READ_BUFFER, getId());
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+
+protected:
+    struct Data {
+        GLuint id;
+        std::size_t size;
+    };
+    std::shared_ptr<Data> data;
+};
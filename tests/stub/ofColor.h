@@ -0,0 +1,64 @@
+//
+//  ofColor.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  only the parts used by the snippets are declared.
+//
+
+#pragma once
+
+#include <limits>
+#include <type_traits>
+
+template <typename pixel_type>
+struct ofColor_ {
+    ofColor_() = default;
+    ofColor_(float r, float g, float b, float a = limit())
+    : r(static_cast<pixel_type>(r))
+    , g(static_cast<pixel_type>(g))
+    , b(static_cast<pixel_type>(b))
+    , a(static_cast<pixel_type>(a))
+    {}
+
+    template <typename other_type>
+    ofColor_(const ofColor_<other_type> &color)
+    : r(static_cast<pixel_type>(color.r * limit() / ofColor_<other_type>::limit()))
+    , g(static_cast<pixel_type>(color.g * limit() / ofColor_<other_type>::limit()))
+    , b(static_cast<pixel_type>(color.b * limit() / ofColor_<other_type>::limit()))
+    , a(static_cast<pixel_type>(color.a * limit() / ofColor_<other_type>::limit()))
+    {}
+
+    void set(float r, float g, float b, float a = limit()) {
+        this->r = static_cast<pixel_type>(r);
+        this->g = static_cast<pixel_type>(g);
+        this->b = static_cast<pixel_type>(b);
+        this->a = static_cast<pixel_type>(a);
+    }
+
+    bool operator==(const ofColor_ &x) const
+    { return r == x.r && g == x.g && b == x.b && a == x.a; }
+    bool operator!=(const ofColor_ &x) const
+    { return !(*this == x); }
+
+    static float limit()
+    { return std::is_floating_point<pixel_type>::value ? 1.0f : static_cast<float>(std::numeric_limits<pixel_type>::max()); }
+
+    static const ofColor_ white, gray, black, red, yellow, cyan, magenta;
+
+    pixel_type r{static_cast<pixel_type>(limit())};
+    pixel_type g{static_cast<pixel_type>(limit())};
+    pixel_type b{static_cast<pixel_type>(limit())};
+    pixel_type a{static_cast<pixel_type>(limit())};
+};
+
+template <typename pixel_type> const ofColor_<pixel_type> ofColor_<pixel_type>::white{limit(), limit(), limit()};
+template <typename pixel_type> const ofColor_<pixel_type> ofColor_<pixel_type>::gray{limit() / 2, limit() / 2, limit() / 2};
+template <typename pixel_type> const ofColor_<pixel_type> ofColor_<pixel_type>::black{0, 0, 0};
+template <typename pixel_type> const ofColor_<pixel_type> ofColor_<pixel_type>::red{limit(), 0, 0};
+template <typename pixel_type> const ofColor_<pixel_type> ofColor_<pixel_type>::yellow{limit(), limit(), 0};
+template <typename pixel_type> const ofColor_<pixel_type> ofColor_<pixel_type>::cyan{0, limit(), limit()};
+template <typename pixel_type> const ofColor_<pixel_type> ofColor_<pixel_type>::magenta{limit(), 0, limit()};
+
+using ofColor = ofColor_<unsigned char>;
+using ofShortColor = ofColor_<unsigned short>;
+using ofFloatColor = ofColor_<float>;
@@ -0,0 +1,164 @@
+//
+//  ofFbo.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  real GL framebuffer (color textures and optional depth / stencil renderbuffer).
+//  numSamples is ignored (no multisample resolve). draw() draws nothing.
+//
+
+#pragma once
+
+#include "ofGLBaseTypes.h"
+#include "ofGLUtils.h"
+#include "ofGraphicsBaseTypes.h"
+#include "ofTexture.h"
+#include "ofPixels.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+enum ofFboMode : short {
+    OF_FBOMODE_NODEFAULTS = 0,
+    OF_FBOMODE_PERSPECTIVE = 1,
+    OF_FBOMODE_MATRIXFLIP = 2
+};
+
+inline ofFboMode operator|(ofFboMode x, ofFboMode y)
+{ return static_cast<ofFboMode>(static_cast<short>(x) | static_cast<short>(y)); }
+
+struct ofFboSettings {
+    int width{0};
+    int height{0};
+    int numColorbuffers{1};
+    std::vector<GLint> colorFormats;
+    bool useDepth{false};
+    bool useStencil{false};
+    bool depthStencilAsTexture{false};
+    GLenum textureTarget{GL_TEXTURE_2D};
+    GLint internalformat{GL_RGBA};
+    int depthStencilInternalFormat{GL_DEPTH_COMPONENT24};
+    int wrapModeHorizontal{GL_CLAMP_TO_EDGE};
+    int wrapModeVertical{GL_CLAMP_TO_EDGE};
+    int minFilter{GL_LINEAR};
+    int maxFilter{GL_LINEAR};
+    int numSamples{0};
+};
+
+class ofFbo : public ofBaseDraws, public ofBaseHasTexture {
+public:
+    ofFbo() = default;
+    ofFbo(const ofFbo &) = delete;
+    ofFbo &operator=(const ofFbo &) = delete;
+    ofFbo(ofFbo &&other) noexcept
+    { *this = std::move(other); }
+    ofFbo &operator=(ofFbo &&other) noexcept {
+        if(this == &other) return *this;
+        clear();
+        settings = other.settings;
+        std::swap(fbo, other.fbo);
+        std::swap(depth_buffer, other.depth_buffer);
+        textures = std::move(other.textures);
+        depth_texture = std::move(other.depth_texture);
+        return *this;
+    }
+    ~ofFbo()
+    { clear(); }
+
+    void allocate(int width, int height, int internal_format = GL_RGBA, int num_samples = 0) {
+        ofFboSettings settings;
+        settings.width = width;
+        settings.height = height;
+        settings.internalformat = internal_format;
+        settings.numSamples = num_samples;
+        allocate(settings);
+    }
+
+    void allocate(ofFboSettings settings) {
+        clear();
+        this->settings = settings;
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        std::vector<GLint> formats = settings.colorFormats;
+        if(formats.empty()) formats.assign(std::max(settings.numColorbuffers, 1), settings.internalformat);
+        std::vector<GLenum> draw_buffers;
+        for(std::size_t i = 0; i < formats.size(); ++i) {
+            textures.emplace_back();
+            textures.back().allocate(settings.width, settings.height, formats[i]);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D,
+                                   textures.back().getTextureData().textureID, 0);
+            draw_buffers.push_back(GL_COLOR_ATTACHMENT0 + i);
+        }
+        glDrawBuffers(static_cast<GLsizei>(draw_buffers.size()), draw_buffers.data());
+        if(settings.useDepth || settings.useStencil) {
+            glGenRenderbuffers(1, &depth_buffer);
+            glBindRenderbuffer(GL_RENDERBUFFER, depth_buffer);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, settings.width, settings.height);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth_buffer);
+            glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    void clear() {
+        textures.clear();
+        if(depth_buffer) glDeleteRenderbuffers(1, &depth_buffer);
+        if(fbo) glDeleteFramebuffers(1, &fbo);
+        depth_buffer = 0;
+        fbo = 0;
+    }
+
+    bool isAllocated() const
+    { return fbo != 0; }
+
+    void begin(ofFboMode = OF_FBOMODE_PERSPECTIVE | OF_FBOMODE_MATRIXFLIP) const {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glViewport(0, 0, settings.width, settings.height);
+    }
+    void end() const
+    { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+
+    void bind() const
+    { glBindFramebuffer(GL_FRAMEBUFFER, fbo); }
+    void unbind() const
+    { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+
+    template <typename pixel_type>
+    void readToPixels(ofPixels_<pixel_type> &pixels, int attachment = 0) const
+    { getTexture(attachment).readToPixels(pixels); }
+
+    ofTexture &getTexture() override
+    { return textures[0]; }
+    const ofTexture &getTexture() const override
+    { return textures[0]; }
+    ofTexture &getTexture(int attachment)
+    { return textures[attachment]; }
+    const ofTexture &getTexture(int attachment) const
+    { return textures[attachment]; }
+    ofTexture &getDepthTexture()
+    { return depth_texture; }
+    const ofTexture &getDepthTexture() const
+    { return depth_texture; }
+
+    void setUseTexture(bool) override {}
+    bool isUsingTexture() const override
+    { return true; }
+
+    using ofBaseDraws::draw;
+    void draw(float, float, float, float) const override {}
+    float getWidth() const override
+    { return static_cast<float>(settings.width); }
+    float getHeight() const override
+    { return static_cast<float>(settings.height); }
+
+    GLuint getId() const
+    { return fbo; }
+
+protected:
+    ofFboSettings settings;
+    GLuint fbo{0};
+    GLuint depth_buffer{0};
+    std::vector<ofTexture> textures;
+    ofTexture depth_texture;
+};
@@ -0,0 +1,14 @@
+//
+//  ofGLBaseTypes.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  GL entry points are linked directly from libOpenGL (glvnd). without current context they do nothing.
+//
+
+#pragma once
+
+#ifndef GL_GLEXT_PROTOTYPES
+#   define GL_GLEXT_PROTOTYPES 1
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
@@ -0,0 +1,53 @@
+//
+//  ofGLUtils.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  covers the internal formats used by the tests (8bit, 16bit float and 32bit float; R, RG, RGB, RGBA).
+//
+
+#pragma once
+
+#include "ofGLBaseTypes.h"
+
+#include <cstddef>
+
+inline GLenum ofGetGLFormatFromInternal(GLint internal_format) {
+    switch(internal_format) {
+        case GL_R8: case GL_R16F: case GL_R32F: return GL_RED;
+        case GL_RG8: case GL_RG16F: case GL_RG32F: return GL_RG;
+        case GL_RGB: case GL_RGB8: case GL_RGB16F: case GL_RGB32F: return GL_RGB;
+        case GL_DEPTH_COMPONENT: case GL_DEPTH_COMPONENT24: case GL_DEPTH_COMPONENT32F: return GL_DEPTH_COMPONENT;
+        default: return GL_RGBA;
+    }
+}
+
+inline GLenum ofGetGLTypeFromInternal(GLint internal_format) {
+    switch(internal_format) {
+        case GL_R16F: case GL_RG16F: case GL_RGB16F: case GL_RGBA16F: return GL_HALF_FLOAT;
+        case GL_R32F: case GL_RG32F: case GL_RGB32F: case GL_RGBA32F: case GL_DEPTH_COMPONENT32F: return GL_FLOAT;
+        case GL_DEPTH_COMPONENT: case GL_DEPTH_COMPONENT24: return GL_UNSIGNED_INT;
+        default: return GL_UNSIGNED_BYTE;
+    }
+}
+
+inline int ofGetNumChannelsFromGLFormat(GLenum format) {
+    switch(format) {
+        case GL_RED: case GL_DEPTH_COMPONENT: return 1;
+        case GL_RG: return 2;
+        case GL_RGB: return 3;
+        default: return 4;
+    }
+}
+
+inline int ofGetBytesPerChannelFromGLType(GLenum type) {
+    switch(type) {
+        case GL_HALF_FLOAT: case GL_UNSIGNED_SHORT: return 2;
+        case GL_FLOAT: case GL_UNSIGNED_INT: return 4;
+        default: return 1;
+    }
+}
+
+inline void ofSetPixelStoreiAlignment(GLenum pname, int width, int bytes_per_channel, int num_channels) {
+    const int stride = width * bytes_per_channel * num_channels;
+    glPixelStorei(pname, stride % 8 == 0 ? 8 : stride % 4 == 0 ? 4 : stride % 2 == 0 ? 2 : 1);
+}
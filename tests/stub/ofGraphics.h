@@ -0,0 +1,47 @@
+//
+//  ofGraphics.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  ofSetColor only records the current color (see ofGetStyle()).
+//
+
+#pragma once
+
+#include "ofColor.h"
+#include "ofGLBaseTypes.h"
+
+#include <vector>
+
+struct ofStyle {
+    ofColor color{255, 255, 255, 255};
+};
+
+namespace ofStub {
+    inline std::vector<ofStyle> &style_stack() {
+        static std::vector<ofStyle> stack(1);
+        return stack;
+    }
+};
+
+inline const ofStyle &ofGetStyle()
+{ return ofStub::style_stack().back(); }
+
+inline void ofPushStyle()
+{ ofStub::style_stack().push_back(ofStub::style_stack().back()); }
+inline void ofPopStyle() {
+    if(1 < ofStub::style_stack().size()) ofStub::style_stack().pop_back();
+}
+
+inline void ofSetColor(const ofColor &color)
+{ ofStub::style_stack().back().color = color; }
+inline void ofSetColor(float r, float g, float b, float a = 255.0f)
+{ ofSetColor(ofColor(r, g, b, a)); }
+inline void ofSetColor(float gray)
+{ ofSetColor(gray, gray, gray); }
+
+inline void ofEnableAlphaBlending() {}
+
+inline void ofClear(float r, float g, float b, float a = 0.0f) {
+    glClearColor(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+}
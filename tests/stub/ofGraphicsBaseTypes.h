@@ -0,0 +1,28 @@
+//
+//  ofGraphicsBaseTypes.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//
+
+#pragma once
+
+class ofTexture;
+
+class ofBaseDraws {
+public:
+    virtual ~ofBaseDraws() {}
+    virtual void draw(float x, float y, float w, float h) const = 0;
+    virtual void draw(float x, float y) const
+    { draw(x, y, getWidth(), getHeight()); }
+    virtual float getWidth() const = 0;
+    virtual float getHeight() const = 0;
+};
+
+class ofBaseHasTexture {
+public:
+    virtual ~ofBaseHasTexture() {}
+    virtual ofTexture &getTexture() = 0;
+    virtual const ofTexture &getTexture() const = 0;
+    virtual void setUseTexture(bool use_texture) = 0;
+    virtual bool isUsingTexture() const = 0;
+};
@@ -0,0 +1,36 @@
+//
+//  ofImage.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//
+
+#pragma once
+
+#include "ofGraphicsBaseTypes.h"
+#include "ofPixels.h"
+#include "ofTexture.h"
+
+template <typename pixel_type>
+class ofImage_ : public ofBaseDraws {
+public:
+    void allocate(int width, int height, int num_channels)
+    { pixels.allocate(width, height, num_channels); }
+
+    ofPixels_<pixel_type> &getPixels()
+    { return pixels; }
+    const ofPixels_<pixel_type> &getPixels() const
+    { return pixels; }
+
+    using ofBaseDraws::draw;
+    void draw(float, float, float, float) const override {}
+    float getWidth() const override
+    { return static_cast<float>(pixels.getWidth()); }
+    float getHeight() const override
+    { return static_cast<float>(pixels.getHeight()); }
+
+protected:
+    ofPixels_<pixel_type> pixels;
+};
+
+using ofImage = ofImage_<unsigned char>;
+using ofFloatImage = ofImage_<float>;
@@ -0,0 +1,134 @@
+//
+//  ofLog.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//
+
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+
+enum ofLogLevel {
+    OF_LOG_VERBOSE,
+    OF_LOG_NOTICE,
+    OF_LOG_WARNING,
+    OF_LOG_ERROR,
+    OF_LOG_FATAL_ERROR,
+    OF_LOG_SILENT
+};
+
+inline std::string ofGetLogLevelName(ofLogLevel level, bool pad = false) {
+    static const char *names[] = {"verbose", "notice", "warning", "error", "fatal", "silent"};
+    std::string name = names[level];
+    if(pad) name.resize(7, ' ');
+    return name;
+}
+
+inline std::string ofVAArgsToString(const char *format, va_list args) {
+    char buffer[1024];
+    std::vsnprintf(buffer, sizeof(buffer), format, args);
+    return buffer;
+}
+
+class ofBaseLoggerChannel {
+public:
+    virtual ~ofBaseLoggerChannel() {}
+    virtual void log(ofLogLevel level, const std::string &module, const std::string &message) = 0;
+    virtual void log(ofLogLevel level, const std::string &module, const char *format, ...) = 0;
+    virtual void log(ofLogLevel level, const std::string &module, const char *format, va_list args) = 0;
+};
+
+class ofConsoleLoggerChannel : public ofBaseLoggerChannel {
+public:
+    void log(ofLogLevel level, const std::string &module, const std::string &message) override
+    { std::fprintf(stderr, "[%s] %s: %s\n", ofGetLogLevelName(level).c_str(), module.c_str(), message.c_str()); }
+    void log(ofLogLevel level, const std::string &module, const char *format, ...) override {
+        va_list args;
+        va_start(args, format);
+        log(level, module, format, args);
+        va_end(args);
+    }
+    void log(ofLogLevel level, const std::string &module, const char *format, va_list args) override
+    { log(level, module, ofVAArgsToString(format, args)); }
+};
+
+namespace ofStub {
+    inline std::shared_ptr<ofBaseLoggerChannel> &logger_channel() {
+        static std::shared_ptr<ofBaseLoggerChannel> channel = std::make_shared<ofConsoleLoggerChannel>();
+        return channel;
+    }
+    inline ofLogLevel &log_level() {
+        static ofLogLevel level = OF_LOG_NOTICE;
+        return level;
+    }
+};
+
+inline void ofSetLoggerChannel(std::shared_ptr<ofBaseLoggerChannel> channel)
+{ ofStub::logger_channel() = channel; }
+inline std::shared_ptr<ofBaseLoggerChannel> ofGetLoggerChannel()
+{ return ofStub::logger_channel(); }
+inline void ofSetLogLevel(ofLogLevel level)
+{ ofStub::log_level() = level; }
+inline ofLogLevel ofGetLogLevel()
+{ return ofStub::log_level(); }
+
+class ofLog {
+public:
+    ofLog()
+    : ofLog(OF_LOG_NOTICE, "")
+    {}
+    explicit ofLog(ofLogLevel level, const std::string &module = "")
+    : level(level)
+    , module(module)
+    {}
+    ofLog(const ofLog &) = delete;
+    ~ofLog() {
+        auto &channel = ofStub::logger_channel();
+        if(channel && ofStub::log_level() <= level && level != OF_LOG_SILENT) {
+            channel->log(level, module, stream.str());
+        }
+    }
+
+    template <typename value_type>
+    ofLog &operator<<(const value_type &value) {
+        stream << value;
+        return *this;
+    }
+
+protected:
+    ofLogLevel level;
+    std::string module;
+    std::ostringstream stream;
+};
+
+class ofLogVerbose : public ofLog {
+public:
+    explicit ofLogVerbose(const std::string &module = "")
+    : ofLog(OF_LOG_VERBOSE, module)
+    {}
+};
+
+class ofLogNotice : public ofLog {
+public:
+    explicit ofLogNotice(const std::string &module = "")
+    : ofLog(OF_LOG_NOTICE, module)
+    {}
+};
+
+class ofLogWarning : public ofLog {
+public:
+    explicit ofLogWarning(const std::string &module = "")
+    : ofLog(OF_LOG_WARNING, module)
+    {}
+};
+
+class ofLogError : public ofLog {
+public:
+    explicit ofLogError(const std::string &module = "")
+    : ofLog(OF_LOG_ERROR, module)
+    {}
+};
@@ -0,0 +1,80 @@
+//
+//  ofMesh.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  draw() draws nothing, so benchmarks measure only the CPU side of mesh building.
+//
+
+#pragma once
+
+#include "ofColor.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace glm {
+    struct vec2 {
+        float x, y;
+    };
+    struct vec3 {
+        float x, y, z;
+    };
+};
+
+enum ofPrimitiveMode {
+    OF_PRIMITIVE_TRIANGLES,
+    OF_PRIMITIVE_TRIANGLE_STRIP,
+    OF_PRIMITIVE_LINES,
+    OF_PRIMITIVE_POINTS
+};
+
+template <typename vertex_type, typename normal_type, typename color_type, typename tex_coord_type>
+class ofMesh_ {
+public:
+    void clear() {
+        vertices.clear();
+        colors.clear();
+        tex_coords.clear();
+    }
+    void setMode(ofPrimitiveMode mode)
+    { this->mode = mode; }
+    ofPrimitiveMode getMode() const
+    { return mode; }
+
+    void addVertex(const vertex_type &vertex)
+    { vertices.push_back(vertex); }
+    void addVertices(const std::vector<vertex_type> &vertices)
+    { this->vertices.insert(this->vertices.end(), vertices.begin(), vertices.end()); }
+    void addTexCoords(const std::vector<tex_coord_type> &tex_coords)
+    { this->tex_coords.insert(this->tex_coords.end(), tex_coords.begin(), tex_coords.end()); }
+    void addColor(const color_type &color)
+    { colors.push_back(color); }
+
+    std::vector<vertex_type> &getVertices()
+    { return vertices; }
+    const std::vector<vertex_type> &getVertices() const
+    { return vertices; }
+    std::vector<tex_coord_type> &getTexCoords()
+    { return tex_coords; }
+    const std::vector<tex_coord_type> &getTexCoords() const
+    { return tex_coords; }
+    std::vector<color_type> &getColors()
+    { return colors; }
+    const std::vector<color_type> &getColors() const
+    { return colors; }
+
+    std::size_t getNumVertices() const
+    { return vertices.size(); }
+    std::size_t getNumColors() const
+    { return colors.size(); }
+
+    void draw() const {}
+
+protected:
+    ofPrimitiveMode mode{OF_PRIMITIVE_TRIANGLES};
+    std::vector<vertex_type> vertices;
+    std::vector<color_type> colors;
+    std::vector<tex_coord_type> tex_coords;
+};
+
+using ofMesh = ofMesh_<glm::vec3, glm::vec3, ofFloatColor, glm::vec2>;
@@ -0,0 +1,66 @@
+//
+//  ofPixels.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+template <typename pixel_type>
+class ofPixels_ {
+public:
+    void allocate(std::size_t width, std::size_t height, std::size_t num_channels) {
+        this->width = width;
+        this->height = height;
+        this->num_channels = num_channels;
+        data.assign(width * height * num_channels, pixel_type{});
+    }
+
+    void setFromPixels(const pixel_type *pixels, std::size_t width, std::size_t height, std::size_t num_channels) {
+        allocate(width, height, num_channels);
+        std::copy(pixels, pixels + data.size(), data.begin());
+    }
+
+    void clear() {
+        data.clear();
+        width = height = num_channels = 0;
+    }
+
+    bool isAllocated() const
+    { return !data.empty(); }
+
+    std::size_t getWidth() const
+    { return width; }
+    std::size_t getHeight() const
+    { return height; }
+    std::size_t getNumChannels() const
+    { return num_channels; }
+    std::size_t size() const
+    { return data.size(); }
+    std::size_t getTotalBytes() const
+    { return data.size() * sizeof(pixel_type); }
+
+    pixel_type *getData()
+    { return data.data(); }
+    const pixel_type *getData() const
+    { return data.data(); }
+
+    pixel_type &operator[](std::size_t i)
+    { return data[i]; }
+    const pixel_type &operator[](std::size_t i) const
+    { return data[i]; }
+
+protected:
+    std::vector<pixel_type> data;
+    std::size_t width{0};
+    std::size_t height{0};
+    std::size_t num_channels{0};
+};
+
+using ofPixels = ofPixels_<unsigned char>;
+using ofShortPixels = ofPixels_<unsigned short>;
+using ofFloatPixels = ofPixels_<float>;
@@ -0,0 +1,104 @@
+//
+//  ofTexture.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  copies share the GL texture like openFrameworks. draw() draws nothing.
+//
+
+#pragma once
+
+#include "ofGLBaseTypes.h"
+#include "ofGLUtils.h"
+#include "ofGraphicsBaseTypes.h"
+#include "ofBufferObject.h"
+#include "ofPixels.h"
+
+#include <memory>
+#include <type_traits>
+
+struct ofTextureData {
+    GLuint textureID{0};
+    GLenum textureTarget{GL_TEXTURE_2D};
+    GLint glInternalFormat{GL_RGBA8};
+    float width{0.0f};
+    float height{0.0f};
+};
+
+class ofTexture : public ofBaseDraws {
+public:
+    void allocate(int width, int height, int internal_format) {
+        GLuint id = 0;
+        glGenTextures(1, &id);
+        owner = std::shared_ptr<GLuint>(new GLuint{id}, [](GLuint *id) {
+            glDeleteTextures(1, id);
+            delete id;
+        });
+        data.textureID = id;
+        data.textureTarget = GL_TEXTURE_2D;
+        data.glInternalFormat = internal_format;
+        data.width = static_cast<float>(width);
+        data.height = static_cast<float>(height);
+        glBindTexture(GL_TEXTURE_2D, id);
+        glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0,
+                     ofGetGLFormatFromInternal(internal_format), ofGetGLTypeFromInternal(internal_format), nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void clear() {
+        owner.reset();
+        data = ofTextureData{};
+    }
+
+    bool isAllocated() const
+    { return data.textureID != 0; }
+
+    const ofTextureData &getTextureData() const
+    { return data; }
+    ofTextureData &getTextureData()
+    { return data; }
+
+    void bind() const
+    { glBindTexture(data.textureTarget, data.textureID); }
+    void unbind() const
+    { glBindTexture(data.textureTarget, 0); }
+
+    using ofBaseDraws::draw;
+    void draw(float, float, float, float) const override {}
+    float getWidth() const override
+    { return data.width; }
+    float getHeight() const override
+    { return data.height; }
+
+    // same as openFrameworks: glGetTexImage into GL_PIXEL_PACK_BUFFER
+    void copyTo(ofBufferObject &buffer) const {
+        const GLenum format = ofGetGLFormatFromInternal(data.glInternalFormat);
+        const GLenum type = ofGetGLTypeFromInternal(data.glInternalFormat);
+        ofSetPixelStoreiAlignment(GL_PACK_ALIGNMENT, static_cast<int>(data.width),
+                                  ofGetBytesPerChannelFromGLType(type), ofGetNumChannelsFromGLFormat(format));
+        buffer.bind(GL_PIXEL_PACK_BUFFER);
+        glBindTexture(data.textureTarget, data.textureID);
+        glGetTexImage(data.textureTarget, 0, format, type, nullptr);
+        glBindTexture(data.textureTarget, 0);
+        buffer.unbind(GL_PIXEL_PACK_BUFFER);
+    }
+
+    template <typename pixel_type>
+    void readToPixels(ofPixels_<pixel_type> &pixels) const {
+        const GLenum format = ofGetGLFormatFromInternal(data.glInternalFormat);
+        const int num_channels = ofGetNumChannelsFromGLFormat(format);
+        const GLenum type = std::is_same<pixel_type, float>::value ? GL_FLOAT
+                          : std::is_same<pixel_type, unsigned short>::value ? GL_UNSIGNED_SHORT
+                          : GL_UNSIGNED_BYTE;
+        pixels.allocate(static_cast<std::size_t>(data.width), static_cast<std::size_t>(data.height), num_channels);
+        ofSetPixelStoreiAlignment(GL_PACK_ALIGNMENT, static_cast<int>(data.width), sizeof(pixel_type), num_channels);
+        glBindTexture(data.textureTarget, data.textureID);
+        glGetTexImage(data.textureTarget, 0, format, type, pixels.getData());
+        glBindTexture(data.textureTarget, 0);
+    }
+
+protected:
+    ofTextureData data;
+    std::shared_ptr<GLuint> owner;
+};
@@ -0,0 +1,52 @@
+//
+//  ofUtils.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  ofGetElapsedTimef() is a fake clock which goes forward only by ofStub::setElapsedTimef().
+//  includes ofLog.h and standard streams like ofConstants.h of openFrameworks.
+//
+
+#pragma once
+
+#include "ofColor.h"
+#include "ofLog.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace ofStub {
+    inline float &elapsed_time() {
+        static float time = 0.0f;
+        return time;
+    }
+    inline void setElapsedTimef(float time)
+    { elapsed_time() = time; }
+
+    inline int &window_height() {
+        static int height = 768;
+        return height;
+    }
+};
+
+inline float ofGetElapsedTimef()
+{ return ofStub::elapsed_time(); }
+
+inline int ofGetWidth()
+{ return 1024; }
+inline int ofGetHeight()
+{ return ofStub::window_height(); }
+
+inline float ofClamp(float value, float min, float max)
+{ return std::min(std::max(value, min), max); }
+
+inline float ofMap(float value, float input_min, float input_max, float output_min, float output_max, bool clamp = false) {
+    const float output = output_min + (value - input_min) / (input_max - input_min) * (output_max - output_min);
+    return clamp ? ofClamp(output, std::min(output_min, output_max), std::max(output_min, output_max)) : output;
+}
+
+inline std::string ofToDataPath(const std::string &path, bool = false)
+{ return path; }
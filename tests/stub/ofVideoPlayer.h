@@ -0,0 +1,57 @@
+//
+//  ofVideoPlayer.h
+//
+//  stand-in of openFrameworks for headless tests and benchmarks.
+//  synthetic player: every update() of a playing player decodes a new frame.
+//
+
+#pragma once
+
+#include "ofGraphicsBaseTypes.h"
+#include "ofPixels.h"
+
+class ofVideoPlayer : public ofBaseDraws {
+public:
+    void update() {
+        is_frame_new = !is_paused;
+        if(is_paused) return;
+        ++current_frame;
+        if(pixels.isAllocated()) pixels[0] = static_cast<unsigned char>(current_frame);
+    }
+    bool isFrameNew() const
+    { return is_frame_new; }
+
+    void play()
+    { is_paused = false; }
+    void stop()
+    { is_paused = true; }
+    bool isPaused() const
+    { return is_paused; }
+    void setPaused(bool is_paused)
+    { this->is_paused = is_paused; }
+    bool isPlaying() const
+    { return !is_paused; }
+
+    void setFrame(int frame)
+    { current_frame = frame; }
+    int getCurrentFrame() const
+    { return current_frame; }
+
+    ofPixels &getPixels()
+    { return pixels; }
+    const ofPixels &getPixels() const
+    { return pixels; }
+
+    using ofBaseDraws::draw;
+    void draw(float, float, float, float) const override {}
+    float getWidth() const override
+    { return static_cast<float>(pixels.getWidth()); }
+    float getHeight() const override
+    { return static_cast<float>(pixels.getHeight()); }
+
+protected:
+    ofPixels pixels;
+    int current_frame{0};
+    bool is_paused{false};
+    bool is_frame_new{false};
+};
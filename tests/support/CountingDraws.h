@@ -0,0 +1,36 @@
+//
+//  CountingDraws.h
+//
+//  ofBaseDraws which only counts draw() calls and remembers the last color.
+//
+
+#pragma once
+
+#include "ofGraphics.h"
+#include "ofGraphicsBaseTypes.h"
+
+#include <cstddef>
+
+namespace ofStub {
+    struct CountingDraws : public ofBaseDraws {
+        CountingDraws(float width = 640.0f, float height = 480.0f)
+        : width{width}
+        , height{height}
+        {}
+
+        using ofBaseDraws::draw;
+        void draw(float, float, float, float) const override {
+            ++num_draws;
+            last_color = ofGetStyle().color;
+        }
+        float getWidth() const override
+        { return width; }
+        float getHeight() const override
+        { return height; }
+
+        float width;
+        float height;
+        mutable std::size_t num_draws{0};
+        mutable ofColor last_color;
+    };
+};
@@ -0,0 +1,59 @@
+//
+//  HeadlessGL.cpp
+//
+
+#include "HeadlessGL.h"
+
+#include "ofGLBaseTypes.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace ofStub {
+    namespace {
+        struct HeadlessGL {
+            HeadlessGL() {
+                auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+                if(!get_platform_display) {
+                    description = "eglGetPlatformDisplayEXT is not available";
+                    return;
+                }
+                display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+                if(display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+                    description = "can't initialize surfaceless EGL display";
+                    return;
+                }
+                eglBindAPI(EGL_OPENGL_API);
+                const EGLint context_attributes[] = {
+                    EGL_CONTEXT_MAJOR_VERSION, 3,
+                    EGL_CONTEXT_MINOR_VERSION, 3,
+                    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                    EGL_NONE
+                };
+                context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, context_attributes);
+                if(context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+                    description = "can't create OpenGL 3.3 core context";
+                    return;
+                }
+                is_available = true;
+                description = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+            }
+
+            EGLDisplay display{EGL_NO_DISPLAY};
+            EGLContext context{EGL_NO_CONTEXT};
+            bool is_available{false};
+            std::string description;
+        };
+
+        HeadlessGL &headless_gl() {
+            static HeadlessGL gl;
+            return gl;
+        }
+    };
+
+    bool ensureHeadlessGL()
+    { return headless_gl().is_available; }
+
+    std::string headlessGLDescription()
+    { return headless_gl().description; }
+};
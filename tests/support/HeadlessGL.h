@@ -0,0 +1,17 @@
+//
+//  HeadlessGL.h
+//
+//  OpenGL context without window for tests and benchmarks (EGL surfaceless, e.g. Mesa llvmpipe).
+//
+
+#pragma once
+
+#include <string>
+
+namespace ofStub {
+    // makes context current on calling thread at first call. false when no EGL device is available.
+    bool ensureHeadlessGL();
+
+    // GL_RENDERER of the context, or reason of failure
+    std::string headlessGLDescription();
+};
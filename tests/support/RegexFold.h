@@ -0,0 +1,73 @@
+//
+//  RegexFold.h
+//
+//  BitmapConsole::fold before it was rewritten as single pass folder.
+//  kept as reference of the output and as baseline of the benchmark.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace ofStub {
+    inline std::string regexFold(const std::string &input, std::size_t num_fold) {
+        if(num_fold == 0) return input;
+        std::regex r("\\s+");
+        std::sregex_token_iterator it(input.begin(), input.end(), r, -1);
+        std::sregex_token_iterator end;
+        std::vector<std::string> words;
+        for(; it != end; ++it) {
+            if(it->str() != "") words.push_back(it->str());
+        }
+
+        std::vector<std::string> lines;
+        std::string current;
+        for(std::size_t i = 0; i < words.size(); ++i){
+            std::string word = words[i];
+            if(current == "") {
+                if(word.size() <= num_fold){
+                    current = word;
+                }
+                else {
+                    for(std::size_t j = 0; j < word.size(); j += num_fold) {
+                        lines.push_back(word.substr(j, num_fold));
+                    }
+                    current = "";
+                }
+            } else {
+                std::string candidate = current + " " + word;
+                if(candidate.size() <= num_fold) {
+                    current = candidate;
+                } else {
+                    lines.push_back(current);
+                    if(word.size() <= num_fold) {
+                        current = word;
+                    } else {
+                        for(std::size_t j = 0; j < word.size(); j += num_fold) {
+                            lines.push_back(word.substr(j, num_fold));
+                        }
+                        current = "";
+                    }
+                }
+            }
+        }
+        if(current != "") lines.push_back(current);
+        for(std::size_t i = 1; i < lines.size(); ++i) {
+            if(!lines[i].empty() && (lines[i][0] == '.' || lines[i][0] == ',' || lines[i][0] == '-')) {
+                char c = lines[i][0];
+                lines[i].erase(0, 1);
+                lines[i - 1] += c;
+            }
+        }
+
+        std::string result;
+        for(std::size_t i = 0; i < lines.size(); ++i) {
+            result += lines[i];
+            if(i < lines.size() - 1) result += "\n";
+        }
+        return result;
+    }
+};
@@ -0,0 +1,34 @@
+//
+//  SyntheticPlayer.h
+//
+//  stub ofVideoPlayer with slow first decode / seek (sleep) and counted draw() calls.
+//
+
+#pragma once
+
+#include "ofVideoPlayer.h"
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace ofStub {
+    struct SyntheticPlayer : public ofVideoPlayer {
+        void update() {
+            if(!isPaused() && getCurrentFrame() == 0) std::this_thread::sleep_for(first_frame_time);
+            ofVideoPlayer::update();
+        }
+        void setFrame(int frame) {
+            std::this_thread::sleep_for(seek_time);
+            ofVideoPlayer::setFrame(frame);
+        }
+
+        using ofBaseDraws::draw;
+        void draw(float, float, float, float) const override
+        { ++num_draws; }
+
+        std::chrono::nanoseconds first_frame_time{0};
+        std::chrono::nanoseconds seek_time{0};
+        mutable std::size_t num_draws{0};
+    };
+};
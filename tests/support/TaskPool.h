@@ -0,0 +1,86 @@
+//
+//  TaskPool.h
+//
+//  minimal persistent thread pool for tests and benchmarks.
+//  operator()(num_tasks, task) has the dispatch signature of
+//  ofxSwitchExecutor::flushParallel and ofxCrossFadePixels::blend.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct TaskPool {
+    // num_threads includes the calling thread of operator()
+    explicit TaskPool(std::size_t num_threads) {
+        for(std::size_t i = 1; i < num_threads; ++i) workers.emplace_back([this] { work_loop(); });
+    }
+    TaskPool(const TaskPool &) = delete;
+    TaskPool &operator=(const TaskPool &) = delete;
+    ~TaskPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            is_stopping = true;
+        }
+        wake.notify_all();
+        for(auto &worker : workers) worker.join();
+    }
+
+    template <typename task_type>
+    void operator()(std::size_t num_tasks, const task_type &task) {
+        std::unique_lock<std::mutex> lock(mutex);
+        current = task;
+        this->num_tasks = num_tasks;
+        next_task = 0;
+        num_active = workers.size();
+        ++generation;
+        ++num_dispatches;
+        lock.unlock();
+        wake.notify_all();
+        run_tasks();
+        lock.lock();
+        done.wait(lock, [this] { return num_active == 0; });
+        current = nullptr;
+    }
+
+    std::size_t numDispatches() const
+    { return num_dispatches; }
+
+private:
+    void run_tasks() {
+        for(std::size_t i; (i = next_task.fetch_add(1, std::memory_order_relaxed)) < num_tasks;) current(i);
+    }
+
+    void work_loop() {
+        std::size_t seen_generation = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true) {
+            wake.wait(lock, [&] { return is_stopping || seen_generation != generation; });
+            if(is_stopping) return;
+            seen_generation = generation;
+            lock.unlock();
+            run_tasks();
+            lock.lock();
+            if(--num_active == 0) done.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::function<void(std::size_t)> current;
+    std::size_t num_tasks{0};
+    std::atomic<std::size_t> next_task{0};
+    std::size_t num_active{0};
+    std::size_t generation{0};
+    std::size_t num_dispatches{0};
+    bool is_stopping{false};
+};
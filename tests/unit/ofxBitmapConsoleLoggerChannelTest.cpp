@@ -0,0 +1,102 @@
+//
+//  ofxBitmapConsoleLoggerChannelTest.cpp
+//
+
+#include "ofxBitmapConsoleLoggerChannel.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+namespace {
+    // counts records given to next channel
+    struct CountingChannel : public ofConsoleLoggerChannel {
+        void log(ofLogLevel, const std::string &, const std::string &) override
+        { ++num_logs; }
+        using ofConsoleLoggerChannel::log;
+
+        std::size_t num_logs{0};
+    };
+
+    struct BitmapConsoleLoggerChannelTest : ::testing::Test {
+        void SetUp() override {
+            previous_channel = ofGetLoggerChannel();
+            previous_level = ofGetLogLevel();
+            ofSetLogLevel(OF_LOG_VERBOSE);
+        }
+        void TearDown() override {
+            ofSetLoggerChannel(previous_channel);
+            ofSetLogLevel(previous_level);
+        }
+
+        std::shared_ptr<ofBaseLoggerChannel> previous_channel;
+        ofLogLevel previous_level;
+    };
+};
+
+TEST_F(BitmapConsoleLoggerChannelTest, DrainsRecordsLoggedOnWorkerThread) {
+    auto channel = std::make_shared<ofxBitmapConsoleLoggerChannel>();
+    auto next = std::make_shared<CountingChannel>();
+    channel->setNext(next);
+    ofSetLoggerChannel(channel);
+    std::thread([] {
+        ofLogNotice("app") << "started";
+        ofLogWarning("net") << "retry " << 3;
+        ofLogError() << "failed";
+        ofLogVerbose("app") << "details";
+    }).join();
+    EXPECT_EQ(channel->numPending(), 4u);
+    EXPECT_EQ(next->num_logs, 4u);
+    EXPECT_EQ(channel->numLogged(OF_LOG_NOTICE), 1u);
+    EXPECT_EQ(channel->numLogged(OF_LOG_WARNING), 1u);
+    EXPECT_EQ(channel->numLogged(OF_LOG_ERROR), 1u);
+    EXPECT_EQ(channel->numLogged(OF_LOG_VERBOSE), 1u);
+    EXPECT_EQ(channel->numLogged(OF_LOG_FATAL_ERROR), 0u);
+
+    ofxBitmapConsole console;
+    console.setup();
+    EXPECT_EQ(channel->drainInto(console), 4u);
+    EXPECT_EQ(channel->numPending(), 0u);
+    ASSERT_EQ(console.size(), 4u);
+
+    const auto &notice = console.getEntry(0);
+    EXPECT_EQ(notice.text, "[notice ] app: started");
+    EXPECT_EQ(notice.tag, "app");
+    EXPECT_FALSE(notice.highlighted);
+
+    const auto &warning = console.getEntry(1);
+    EXPECT_EQ(warning.text, "[warning] net: retry 3");
+    EXPECT_EQ(warning.tag, "net");
+    EXPECT_TRUE(warning.highlighted);
+    EXPECT_EQ(warning.bg_color, ofColor::yellow);
+    EXPECT_EQ(warning.fg_color, ofColor::black);
+
+    const auto &error = console.getEntry(2);
+    EXPECT_EQ(error.text, "[error  ] failed");
+    EXPECT_EQ(error.tag, "");
+    EXPECT_EQ(error.bg_color, ofColor::red);
+    EXPECT_EQ(error.fg_color, ofColor::white);
+
+    EXPECT_EQ(console.getEntry(3).fg_color, ofColor::gray);
+}
+
+TEST_F(BitmapConsoleLoggerChannelTest, CountsDroppedPerLevel) {
+    ofxBitmapConsoleLoggerChannel channel(2);
+    channel.setStyle(OF_LOG_NOTICE, ofColor::white, ofColor::black);
+    for(int i = 0; i < 3; ++i) channel.log(OF_LOG_NOTICE, "", "line %d", i);
+    channel.log(OF_LOG_ERROR, "", "error");
+    EXPECT_EQ(channel.numLogged(OF_LOG_NOTICE), 3u);
+    EXPECT_EQ(channel.numDropped(OF_LOG_NOTICE), 1u);
+    EXPECT_EQ(channel.numDropped(OF_LOG_ERROR), 1u);
+    EXPECT_EQ(channel.numDropped(), 2u);
+    EXPECT_EQ(channel.numLogged(OF_LOG_SILENT), 0u);
+
+    ofxBitmapConsole console;
+    console.setup();
+    EXPECT_EQ(channel.drainInto(console), 2u);
+    ASSERT_EQ(console.size(), 2u);
+    EXPECT_EQ(console.getEntry(1).text, "[notice ] line 1");
+    EXPECT_TRUE(console.getEntry(1).highlighted);
+    EXPECT_EQ(console.getEntry(1).bg_color, ofColor::white);
+}
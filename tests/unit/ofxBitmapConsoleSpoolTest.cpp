@@ -0,0 +1,138 @@
+//
+//  ofxBitmapConsoleSpoolTest.cpp
+//
+
+#include "ofxBitmapConsoleSpool.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+namespace {
+    struct BitmapConsoleSpoolTest : ::testing::Test {
+        void SetUp() override {
+            path = ::testing::TempDir() + "ofxBitmapConsoleSpoolTest.spool";
+            TearDown();
+        }
+        void TearDown() override {
+            std::remove(path.c_str());
+            std::remove((path + ".1").c_str());
+        }
+
+        std::string path;
+    };
+};
+
+TEST_F(BitmapConsoleSpoolTest, ReplaysAfterReopen) {
+    {
+        ofxBitmapConsoleSpool spool;
+        ASSERT_TRUE(spool.open(path, 4096));
+        EXPECT_TRUE(spool.append("plain", "", false, ofColor{}, ofColor{}));
+        EXPECT_TRUE(spool.append("highlighted", "net", true, ofColor::red, ofColor::yellow));
+        EXPECT_EQ(spool.numAppended(), 2u);
+    }
+    {
+        ofxBitmapConsoleSpool spool;
+        ASSERT_TRUE(spool.open(path, 4096));
+        EXPECT_TRUE(spool.append("third", "", false, ofColor{}, ofColor{}));
+    }
+    const auto records = ofxBitmapConsoleSpool::readLast(path, 10);
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].text, "plain");
+    EXPECT_EQ(records[1].text, "highlighted");
+    EXPECT_EQ(records[1].tag, "net");
+    EXPECT_EQ(records[0].tag, "");
+    EXPECT_TRUE(records[1].highlighted);
+    EXPECT_EQ(records[1].bg_color, ofColor::red);
+    EXPECT_EQ(records[1].fg_color, ofColor::yellow);
+    EXPECT_EQ(records[2].text, "third");
+}
+
+TEST_F(BitmapConsoleSpoolTest, RotatesWhenFull) {
+    ofxBitmapConsoleSpool spool;
+    ASSERT_TRUE(spool.open(path, 256));
+    // 24 bytes header + 8 bytes text per record, 6 records per file
+    for(int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(spool.append("line " + std::to_string(i), "", false, ofColor{}, ofColor{}));
+    }
+    EXPECT_EQ(spool.numRotations(), 1u);
+    EXPECT_EQ(spool.numSyncRotations(), 0u);
+    spool.close();
+    const auto records = ofxBitmapConsoleSpool::readLast(path, 100);
+    ASSERT_EQ(records.size(), 10u);
+    EXPECT_EQ(records.front().text, "line 0");
+    EXPECT_EQ(records.back().text, "line 9");
+    EXPECT_EQ(ofxBitmapConsoleSpool::readLast(path, 3).front().text, "line 7");
+}
+
+TEST_F(BitmapConsoleSpoolTest, RejectsTooSmallFile) {
+    ofxBitmapConsoleSpool spool;
+    EXPECT_FALSE(spool.open(path, 16));
+    EXPECT_FALSE(spool.isOpened());
+    EXPECT_FALSE(spool.append("dropped", "", false, ofColor{}, ofColor{}));
+}
+
+TEST_F(BitmapConsoleSpoolTest, RotationSwitchesToPremappedFile) {
+    ofxBitmapConsoleSpool spool;
+    ASSERT_TRUE(spool.open(path, 256));
+    EXPECT_TRUE(spool.isNextReady());
+    for(int i = 0; i < 7; ++i) {
+        ASSERT_TRUE(spool.append("line " + std::to_string(i), "", false, ofColor{}, ofColor{}));
+    }
+    EXPECT_EQ(spool.numRotations(), 1u);
+    EXPECT_FALSE(spool.isNextReady());
+    // full file is renamed by update(). until then, records are read from path and path + ".next"
+    auto records = ofxBitmapConsoleSpool::readLast(path, 100);
+    ASSERT_EQ(records.size(), 7u);
+    EXPECT_EQ(records.back().text, "line 6");
+    spool.update();
+    EXPECT_TRUE(spool.isNextReady());
+    records = ofxBitmapConsoleSpool::readLast(path, 100);
+    ASSERT_EQ(records.size(), 7u);
+    EXPECT_EQ(records.front().text, "line 0");
+    EXPECT_EQ(records.back().text, "line 6");
+    EXPECT_EQ(spool.numSyncRotations(), 0u);
+}
+
+TEST_F(BitmapConsoleSpoolTest, RotatesSynchronouslyWithoutUpdate) {
+    ofxBitmapConsoleSpool spool;
+    ASSERT_TRUE(spool.open(path, 256));
+    for(int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(spool.append("line " + std::to_string(i), "", false, ofColor{}, ofColor{}));
+    }
+    EXPECT_EQ(spool.numRotations(), 3u);
+    EXPECT_EQ(spool.numSyncRotations(), 2u);
+    auto records = ofxBitmapConsoleSpool::readLast(path, 100);
+    ASSERT_EQ(records.size(), 14u);
+    EXPECT_EQ(records.front().text, "line 6");
+    EXPECT_EQ(records.back().text, "line 19");
+    spool.close();
+    records = ofxBitmapConsoleSpool::readLast(path, 100);
+    ASSERT_EQ(records.size(), 8u);
+    EXPECT_EQ(records.front().text, "line 12");
+    EXPECT_EQ(records.back().text, "line 19");
+}
+
+TEST_F(BitmapConsoleSpoolTest, FinishesRotationLeftByCrash) {
+    {
+        ofxBitmapConsoleSpool spool;
+        ASSERT_TRUE(spool.open(path, 256));
+        for(int i = 0; i < 7; ++i) spool.append("line " + std::to_string(i), "", false, ofColor{}, ofColor{});
+        // leaves files as a crash before update() would: path is full, path + ".next" has "line 6"
+        std::rename(path.c_str(), (path + ".full").c_str());
+        std::rename((path + ".next").c_str(), (path + ".active").c_str());
+    }
+    std::rename((path + ".full").c_str(), path.c_str());
+    std::rename((path + ".active").c_str(), (path + ".next").c_str());
+    ofxBitmapConsoleSpool spool;
+    ASSERT_TRUE(spool.open(path, 256));
+    ASSERT_TRUE(spool.append("line 7", "", false, ofColor{}, ofColor{}));
+    spool.close();
+    const auto records = ofxBitmapConsoleSpool::readLast(path, 100);
+    ASSERT_EQ(records.size(), 8u);
+    EXPECT_EQ(records[6].text, "line 6");
+    EXPECT_EQ(records[7].text, "line 7");
+    std::remove((path + ".full").c_str());
+    std::remove((path + ".active").c_str());
+}
@@ -0,0 +1,280 @@
+//
+//  ofxBitmapConsoleTest.cpp
+//
+
+#include "ofxBitmapConsole.h"
+
+#include "RegexFold.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+    struct FoldableConsole : ofx::BitmapConsole {
+        using ofx::BitmapConsole::fold;
+    };
+
+    struct CoalescingConsole : ofx::BitmapConsole {
+        using ofx::BitmapConsole::line_hash;
+        using ofx::BitmapConsole::recent_entries;
+    };
+
+    std::string fold(const std::string &input, std::size_t num_fold) {
+        std::string output;
+        FoldableConsole::fold(input, num_fold, output);
+        return output;
+    }
+};
+
+TEST(BitmapConsole, AddKeepsOrder) {
+    ofxBitmapConsole console;
+    console.setup();
+    console.add("first");
+    console.add("second\nthird");
+    ASSERT_EQ(console.size(), 2u);
+    EXPECT_EQ(console.numLines(), 3u);
+    EXPECT_EQ(console.getEntry(0).text, "first");
+    EXPECT_EQ(console.getEntry(1).text, "second\nthird");
+}
+
+TEST(BitmapConsole, MoveKeepsEntries) {
+    static_assert(!std::is_copy_constructible<ofxBitmapConsole>::value, "console is not copyable");
+    static_assert(!std::is_copy_assignable<ofxBitmapConsole>::value, "console is not copyable");
+    ofxBitmapConsole console;
+    console.setup(ofxBitmapConsole::Settings().arenaChunkSize(64));
+    for(int i = 0; i < 10; ++i) console.add("line " + std::to_string(i));
+    ofxBitmapConsole moved = std::move(console);
+    ASSERT_EQ(moved.size(), 10u);
+    EXPECT_EQ(moved.getEntry(9).text, "line 9");
+    moved.add("line 10");
+    EXPECT_EQ(moved.getEntry(10).text, "line 10");
+}
+
+TEST(BitmapConsole, MaxLinesEvictsOldestEntries) {
+    ofxBitmapConsole console;
+    console.setup(ofxBitmapConsole::Settings().maxLines(4));
+    for(int i = 0; i < 10; ++i) console.add(std::to_string(i));
+    ASSERT_EQ(console.size(), 4u);
+    EXPECT_EQ(console.getEntry(0).text, "6");
+    EXPECT_EQ(console.getEntry(3).text, "9");
+
+    // multi-line entry counts all of its lines
+    console.add("a\nb\nc");
+    EXPECT_EQ(console.size(), 2u);
+    EXPECT_EQ(console.numLines(), 4u);
+}
+
+TEST(BitmapConsole, FixedCapacityWrapsAround) {
+    ofxBitmapConsole console;
+    console.setup(ofxBitmapConsole::Settings().fixedCapacity(8).arenaChunkSize(64));
+    for(int i = 0; i < 100; ++i) console.add("line " + std::to_string(i));
+    ASSERT_EQ(console.size(), 8u);
+    for(std::size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(console.getEntry(i).text, "line " + std::to_string(92 + i));
+    }
+    EXPECT_LE(console.memoryFootprint().text_reserved, 4u * 64u);
+}
+
+TEST(BitmapConsole, FirstVisibleEntryFollowsScroll) {
+    ofxBitmapConsole console;
+    console.setup();
+    console.add("0");
+    console.add("1\n1");
+    console.add("2");
+    console.scrollTo(0);
+    EXPECT_EQ(console.firstVisibleEntry(), 0u);
+    console.scrollTo(1);
+    EXPECT_EQ(console.firstVisibleEntry(), 1u);
+    console.scrollTo(2);
+    EXPECT_EQ(console.firstVisibleEntry(), 1u);
+    console.scrollTo(3);
+    EXPECT_EQ(console.firstVisibleEntry(), 2u);
+    console.scrollBy(-10);
+    EXPECT_EQ(console.scrollOffset(), 0u);
+}
+
+TEST(BitmapConsole, BuildMeshMakesQuadPerGlyph) {
+    ofxBitmapConsole console;
+    console.setup();
+    console.add("abc");
+    console.addHighlight("de");
+    ofMesh glyphs, backgrounds;
+    const float bottom = console.buildMesh(0.0f, 0.0f, 1000.0f, glyphs, backgrounds);
+    EXPECT_EQ(glyphs.getNumVertices(), 5u * 6u);
+    EXPECT_GT(backgrounds.getNumVertices(), 0u);
+    EXPECT_FLOAT_EQ(bottom, 60.0f);
+}
+
+TEST(BitmapConsole, BuildMeshStopsAtHeight) {
+    ofxBitmapConsole console;
+    console.setup();
+    for(int i = 0; i < 100; ++i) console.add("x");
+    ofMesh glyphs, backgrounds;
+    console.buildMesh(0.0f, 0.0f, 200.0f, glyphs, backgrounds);
+    EXPECT_EQ(glyphs.getNumVertices(), 9u * 6u);
+}
+
+TEST(BitmapConsole, PostIsAddedOnUpdate) {
+    ofxBitmapConsole console;
+    console.setup(ofxBitmapConsole::Settings().queueCapacity(4));
+    for(int i = 0; i < 6; ++i) console.post(std::to_string(i));
+    EXPECT_EQ(console.size(), 0u);
+    EXPECT_EQ(console.update(), 4u);
+    EXPECT_EQ(console.size(), 4u);
+    EXPECT_EQ(console.numDropped(), 2u);
+}
+
+TEST(BitmapConsole, FoldPacksWordsGreedily) {
+    EXPECT_EQ(fold("aaa bbb ccc", 7), "aaa bbb\nccc");
+    EXPECT_EQ(fold("  aaa   bbb  ", 10), "aaa bbb");
+    EXPECT_EQ(fold("abcdefghij", 4), "abcd\nefgh\nij");
+    EXPECT_EQ(fold("", 4), "");
+}
+
+TEST(BitmapConsole, FoldMovesLeadingPunctuationUp) {
+    EXPECT_EQ(fold("aaaa .bbb", 4), "aaaa.\nbbb");
+    EXPECT_EQ(fold("aaaa ,", 4), "aaaa,\n");
+}
+
+TEST(BitmapConsole, FoldMatchesRegexFold) {
+    const char *inputs[] = {
+        "aaa bbb ccc", "  aaa   bbb  ", "abcdefghij", "", " \t\n ", "aaaa .bbb", "aaaa ,", "a - b",
+        "aaaa -bbbbbbbbb", "aaaa\tbbbb\ncccc", "x,y.z ,,, ...", "abcdefgh ijkl mnopqrstu v",
+    };
+    for(const char *input : inputs) {
+        for(std::size_t num_fold = 1; num_fold <= 12; ++num_fold) {
+            EXPECT_EQ(fold(input, num_fold), ofStub::regexFold(input, num_fold))
+                << "input \"" << input << "\" num_fold " << num_fold;
+        }
+    }
+}
+
+TEST(BitmapConsole, FoldMatchesRegexFoldOnRandomInput) {
+    static const char alphabet[] = "aaaabbbcc.,-  \t\n";
+    std::mt19937 engine{42};
+    std::uniform_int_distribution<std::size_t> length{0, 64}, letter{0, sizeof(alphabet) - 2}, fold_size{1, 16};
+    for(int n = 0; n < 2000; ++n) {
+        std::string input(length(engine), ' ');
+        for(auto &c : input) c = alphabet[letter(engine)];
+        const auto num_fold = fold_size(engine);
+        ASSERT_EQ(fold(input, num_fold), ofStub::regexFold(input, num_fold))
+            << "input \"" << input << "\" num_fold " << num_fold;
+    }
+}
+
+TEST(BitmapConsole, NumFoldAppliesToAdd) {
+    ofxBitmapConsole console;
+    console.setup(ofxBitmapConsole::Settings().numFold(5));
+    console.add("hello world again");
+    ASSERT_EQ(console.size(), 1u);
+    EXPECT_EQ(console.getEntry(0).text, "hello\nworld\nagain");
+    EXPECT_EQ(console.numLines(), 3u);
+}
+
+TEST(BitmapConsole, CoalesceCountsRepeats) {
+    ofxBitmapConsole console;
+    console.setup(ofxBitmapConsole::Settings().coalesce(1));
+    console.add("same");
+    console.add("same");
+    console.add("other");
+    console.add("same");
+    ASSERT_EQ(console.size(), 3u);
+    EXPECT_EQ(console.getEntry(0).num_repeats, 2u);
+    EXPECT_EQ(console.numCoalesced(), 1u);
+}
+
+TEST(BitmapConsole, CoalesceComparesEntryOnHashHit) {
+    CoalescingConsole console;
+    console.setup(ofxBitmapConsole::Settings().coalesce(4));
+    console.add("first");
+    // pretend hash of "second" collides with "first"
+    console.recent_entries[CoalescingConsole::line_hash("second", "", false, ofColor{}, ofColor{})] = 0;
+    console.add("second");
+    ASSERT_EQ(console.size(), 2u);
+    EXPECT_EQ(console.getEntry(0).num_repeats, 1u);
+    EXPECT_EQ(console.getEntry(1).text, "second");
+    EXPECT_EQ(console.numCoalesced(), 0u);
+
+    // same text with other tag is not a repeat either
+    console.add(ofxBitmapConsole::Line("second").tagged("other"));
+    EXPECT_EQ(console.size(), 3u);
+    console.add("second");
+    EXPECT_EQ(console.getEntry(1).num_repeats, 2u);
+}
+
+TEST(BitmapConsole, CoalesceWorksWithFold) {
+    ofxBitmapConsole console;
+    console.setup(ofxBitmapConsole::Settings().coalesce(4).numFold(8));
+    console.add("long line which is folded");
+    console.add("long line which is folded");
+    ASSERT_EQ(console.size(), 1u);
+    EXPECT_EQ(console.getEntry(0).num_repeats, 2u);
+}
+
+TEST(BitmapConsole, RateLimitPerTag) {
+    ofxClock::shared().setOffline(0.1);
+    ofxBitmapConsole console;
+    // 2 lines per second, burst of 3
+    console.setup(ofxBitmapConsole::Settings().rateLimit(2.0f, 3.0f));
+    for(int i = 0; i < 5; ++i) console.add(ofxBitmapConsole::Line("a " + std::to_string(i)).tagged("a"));
+    console.add(ofxBitmapConsole::Line("b").tagged("b"));
+    EXPECT_EQ(console.size(), 4u);
+    EXPECT_EQ(console.numRateLimited(), 2u);
+
+    // 0.5 sec refills 1 token
+    ofxClock::shared().advance(5);
+    console.add(ofxBitmapConsole::Line("a 5").tagged("a"));
+    console.add(ofxBitmapConsole::Line("a 6").tagged("a"));
+    EXPECT_EQ(console.size(), 5u);
+    EXPECT_EQ(console.numRateLimited(), 3u);
+
+    // refill is capped by burst
+    ofxClock::shared().advance(100);
+    for(int i = 7; i < 11; ++i) console.add(ofxBitmapConsole::Line("a " + std::to_string(i)).tagged("a"));
+    EXPECT_EQ(console.size(), 8u);
+    EXPECT_EQ(console.numRateLimited(), 4u);
+    EXPECT_EQ(console.getEntry(7).text, "a 9");
+    ofxClock::shared().setRealtime();
+}
+
+TEST(BitmapConsole, FilterTracksNewLines) {
+    ofxBitmapConsole console;
+    console.setup(ofxBitmapConsole::Settings().searchIndex(true));
+    console.add("apple pie");
+    console.add("banana");
+    console.setFilter("apple");
+    EXPECT_EQ(console.numFiltered(), 1u);
+    console.add("apple juice");
+    EXPECT_EQ(console.numFiltered(), 2u);
+    console.clearFilter();
+    EXPECT_EQ(console.numFiltered(), 3u);
+}
+
+TEST(BitmapConsole, SpoolReplaysTags) {
+    const std::string path = ::testing::TempDir() + "ofxBitmapConsoleTest.spool";
+    std::remove(path.c_str());
+    std::remove((path + ".1").c_str());
+    const auto settings = ofxBitmapConsole::Settings().spool(path, 4096, 10);
+    {
+        ofxBitmapConsole console;
+        console.setup(settings);
+        console.add(ofxBitmapConsole::Line("connected", ofColor::red, ofColor::white).tagged("net"));
+        console.add("untagged");
+    }
+    ofxBitmapConsole console;
+    console.setup(settings);
+    ASSERT_EQ(console.size(), 2u);
+    EXPECT_EQ(console.getEntry(0).text, "connected");
+    EXPECT_EQ(console.getEntry(0).tag, "net");
+    EXPECT_EQ(console.getEntry(0).bg_color, ofColor::red);
+    EXPECT_EQ(console.getEntry(1).tag, "");
+    console.setFilter("", "net");
+    EXPECT_EQ(console.numFiltered(), 1u);
+    std::remove(path.c_str());
+    std::remove((path + ".1").c_str());
+}
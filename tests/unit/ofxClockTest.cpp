@@ -0,0 +1,29 @@
+//
+//  ofxClockTest.cpp
+//
+
+#include "ofxClock.h"
+
+#include <gtest/gtest.h>
+
+TEST(Clock, OfflineTimeIsStartPlusFrames) {
+    ofxClock clock;
+    clock.setOffline(0.1, 2.0);
+    EXPECT_TRUE(clock.isOffline());
+    EXPECT_DOUBLE_EQ(clock.getElapsedTime(), 2.0);
+    clock.advance(3);
+    EXPECT_EQ(clock.getFrame(), 3u);
+    EXPECT_NEAR(clock.getElapsedTime(), 2.3, 1e-12);
+    // no drift after many frames
+    clock.setFrame(1000000);
+    EXPECT_NEAR(clock.getElapsedTime(), 100002.0, 1e-6);
+}
+
+TEST(Clock, RealtimeFollowsOfGetElapsedTimef) {
+    ofxClock clock;
+    ofStub::setElapsedTimef(4.5f);
+    EXPECT_FALSE(clock.isOffline());
+    EXPECT_FLOAT_EQ(clock.getElapsedTimef(), 4.5f);
+    clock.advance();
+    EXPECT_FLOAT_EQ(clock.getElapsedTimef(), 4.5f);
+}
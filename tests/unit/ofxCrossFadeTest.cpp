@@ -0,0 +1,279 @@
+//
+//  ofxCrossFadeTest.cpp
+//
+//  fades run on offline ofxClock, so progress is exact per frame.
+//
+
+// ofxCrossFade.h expects ofSetColor declared by ofMain.h
+#include "ofGraphics.h"
+#include "ofxCrossFade.h"
+#include "ofxCrossFadePixels.h"
+#include "ofxCrossFadeScheduler.h"
+
+#include "CountingDraws.h"
+#include "SyntheticPlayer.h"
+#include "TaskPool.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    struct OfflineClock : ::testing::Test {
+        void SetUp() override
+        { ofxClock::shared().setOffline(0.1); }
+        void TearDown() override
+        { ofxClock::shared().setRealtime(); }
+    };
+
+    using CrossFadeTest = OfflineClock;
+    using CrossFadeSchedulerTest = OfflineClock;
+    using VideoFaderTest = OfflineClock;
+    using SyntheticVideoFader = ofxBasicVideoFader<ofStub::SyntheticPlayer>;
+};
+
+TEST_F(CrossFadeTest, ProgressFollowsClock) {
+    ofStub::CountingDraws from, to;
+    auto fade = ofxCrossFade::create(from, to, 1.0f);
+    EXPECT_FLOAT_EQ(fade->getProgress(), 0.0f);
+    ofxClock::shared().advance(5);
+    EXPECT_NEAR(fade->getProgress(), 0.5f, 1e-6f);
+    EXPECT_FALSE(fade->update());
+    ofxClock::shared().advance(5);
+    EXPECT_FLOAT_EQ(fade->getProgress(), 1.0f);
+    update(fade);
+    EXPECT_EQ(fade, nullptr);
+}
+
+TEST_F(CrossFadeTest, DrawsBothWithMixAsAlpha) {
+    ofStub::CountingDraws from, to;
+    ofxCrossFade fade(from, to, 1.0f);
+    fade.setCurve(ofx::Ease::InQuad);
+    ofxClock::shared().advance(5);
+    fade.draw(0, 0);
+    EXPECT_EQ(from.num_draws, 1u);
+    EXPECT_EQ(to.num_draws, 1u);
+    EXPECT_EQ(from.last_color.a, 255);
+    EXPECT_NEAR(to.last_color.a, 0.25f * 255.0f, 1.0f);
+}
+
+TEST_F(CrossFadeSchedulerTest, StartsOnNextUpdateAndRetires) {
+    ofStub::CountingDraws from, to;
+    ofxCrossFadeScheduler scheduler;
+    scheduler.setClock(ofxClock::shared());
+    auto first = scheduler.start(from, to, 0.5f);
+    ofxClock::shared().advance(2);
+    scheduler.update();
+    auto second = scheduler.start(from, to, 1.0f);
+    EXPECT_EQ(scheduler.getStats().num_started, 1u);
+    EXPECT_FLOAT_EQ(scheduler.getProgress(first), 0.0f);
+
+    ofxClock::shared().advance(6);
+    scheduler.update();
+    EXPECT_FALSE(scheduler.isActive(first));
+    ASSERT_EQ(scheduler.getCompleted().size(), 1u);
+    EXPECT_EQ(scheduler.getCompleted()[0], first);
+    EXPECT_NEAR(scheduler.getProgress(second), 0.0f, 1e-6f);
+
+    // slot of first is reused, but old handle stays invalid
+    auto third = scheduler.start(from, to, 1.0f);
+    EXPECT_EQ(third.index, first.index);
+    EXPECT_FALSE(scheduler.isActive(first));
+    EXPECT_EQ(scheduler.numActive(), 2u);
+    EXPECT_EQ(scheduler.getStats().capacity, 2u);
+
+    scheduler.draw(second, 0, 0, 10, 10);
+    scheduler.draw(first, 0, 0, 10, 10);
+    EXPECT_EQ(to.num_draws, 1u);
+}
+
+TEST_F(CrossFadeSchedulerTest, MixMatchesCrossFade) {
+    ofStub::CountingDraws from, to;
+    ofxCrossFadeScheduler scheduler;
+    scheduler.update();
+    auto handle = scheduler.start(from, to, 1.0f, ofx::Ease::OutCubic);
+    scheduler.update();
+    ofxCrossFade fade(from, to, 1.0f);
+    fade.setCurve(ofx::Ease::OutCubic);
+    for(int i = 0; i < 9; ++i) {
+        ofxClock::shared().advance();
+        scheduler.update();
+        EXPECT_FLOAT_EQ(scheduler.getMix(handle), fade.getMix());
+    }
+}
+
+TEST_F(VideoFaderTest, PrerollWarmsToWithoutDrawing) {
+    ofVideoPlayer from, to;
+    from.getPixels().allocate(4, 4, 3);
+    to.getPixels().allocate(4, 4, 3);
+    to.stop();
+    auto fader = ofxVideoFader::create(from, to, 1.0f, ofxVideoFader::Settings().preroll(3));
+    EXPECT_EQ(fader->getPhase(), ofxVideoFader::Phase::Preroll);
+    EXPECT_FALSE(to.isPaused());
+    for(int i = 0; i < 2; ++i) {
+        fader->update();
+        EXPECT_EQ(fader->getPhase(), ofxVideoFader::Phase::Preroll);
+        ofxClock::shared().advance();
+        EXPECT_FLOAT_EQ(fader->getMix(), 0.0f);
+    }
+    fader->update();
+    EXPECT_EQ(fader->getPhase(), ofxVideoFader::Phase::Fading);
+    EXPECT_EQ(to.getCurrentFrame(), 3);
+    EXPECT_EQ(fader->getStats().num_preroll_frames, 3u);
+    EXPECT_EQ(fader->getStats().num_preroll_updates, 3u);
+    EXPECT_NEAR(fader->getStats().preroll_time, 0.2f, 1e-5f);
+}
+
+TEST_F(VideoFaderTest, PrerollDrawsOnlyFrom) {
+    ofStub::SyntheticPlayer from, to;
+    auto fader = SyntheticVideoFader::create(from, to, 1.0f, SyntheticVideoFader::Settings().preroll(1));
+    fader->draw(0, 0);
+    EXPECT_EQ(from.num_draws, 1u);
+    EXPECT_EQ(to.num_draws, 0u);
+    fader->update();
+    fader->draw(0, 0);
+    EXPECT_EQ(to.num_draws, 1u);
+}
+
+TEST_F(VideoFaderTest, RewindsOnCompletingUpdateByDefault) {
+    ofVideoPlayer from, to;
+    auto fader = ofxVideoFader::create(from, to, 0.5f);
+    for(int i = 0; i < 4; ++i) {
+        EXPECT_FALSE(fader->update());
+        ofxClock::shared().advance();
+    }
+    ofxClock::shared().advance();
+    EXPECT_TRUE(fader->update());
+    EXPECT_TRUE(from.isPaused());
+    EXPECT_EQ(from.getCurrentFrame(), 0);
+    EXPECT_EQ(to.getCurrentFrame(), 5);
+    EXPECT_EQ(fader->getPhase(), ofxVideoFader::Phase::Completed);
+}
+
+TEST_F(VideoFaderTest, DeferredRewind) {
+    ofVideoPlayer from, to;
+    auto fader = ofxVideoFader::create(from, to, 0.1f, ofxVideoFader::Settings().rewind(true, 2));
+    ofxClock::shared().advance();
+    EXPECT_FALSE(fader->update());
+    EXPECT_EQ(fader->getPhase(), ofxVideoFader::Phase::Rewinding);
+    EXPECT_TRUE(from.isPaused());
+    EXPECT_EQ(from.getCurrentFrame(), 1);
+    EXPECT_FALSE(fader->update());
+    EXPECT_EQ(from.getCurrentFrame(), 1);
+    EXPECT_TRUE(fader->update());
+    EXPECT_EQ(from.getCurrentFrame(), 0);
+}
+
+TEST_F(VideoFaderTest, NoRewind) {
+    ofVideoPlayer from, to;
+    auto fader = ofxVideoFader::create(from, to, 0.1f, ofxVideoFader::Settings().rewind(false));
+    ofxClock::shared().advance();
+    EXPECT_TRUE(fader->update());
+    EXPECT_TRUE(from.isPaused());
+    EXPECT_EQ(from.getCurrentFrame(), 1);
+    EXPECT_EQ(fader->getStats().rewind_nanos, 0u);
+}
+
+TEST_F(VideoFaderTest, StatsMeasureHitches) {
+    // first decode of `to` and seek of `from` are slow
+    ofStub::SyntheticPlayer from, to;
+    from.seek_time = std::chrono::milliseconds(5);
+    to.first_frame_time = std::chrono::milliseconds(5);
+    auto fader = SyntheticVideoFader::create(from, to, 0.2f);
+    fader->update();
+    ofxClock::shared().advance(2);
+    EXPECT_TRUE(fader->update());
+    const auto &stats = fader->getStats();
+    EXPECT_GE(stats.start_hitch_nanos, 5000000u);
+    EXPECT_GE(stats.max_fade_update_nanos, stats.start_hitch_nanos);
+    EXPECT_GE(stats.rewind_nanos, 5000000u);
+    EXPECT_EQ(stats.preroll_nanos, 0u);
+}
+
+TEST_F(VideoFaderTest, PrerollMovesHitchOutOfFade) {
+    ofStub::SyntheticPlayer from, to;
+    to.first_frame_time = std::chrono::milliseconds(5);
+    to.stop();
+    auto fader = SyntheticVideoFader::create(from, to, 0.2f, SyntheticVideoFader::Settings().preroll(1));
+    fader->update();
+    fader->update();
+    const auto &stats = fader->getStats();
+    EXPECT_GE(stats.preroll_nanos, 5000000u);
+    EXPECT_LT(stats.start_hitch_nanos, 5000000u);
+}
+
+TEST(CrossFadePixels, MatchesScalarBlend) {
+    ofPixels from, to, dst;
+    from.allocate(37, 11, 4);
+    to.allocate(37, 11, 4);
+    for(std::size_t i = 0; i < from.size(); ++i) {
+        from[i] = static_cast<unsigned char>(i * 7);
+        to[i] = static_cast<unsigned char>(255 - i * 3);
+    }
+    for(float alpha : {0.0f, 0.3f, 0.5f, 1.0f}) {
+        ASSERT_TRUE(ofxCrossFadePixels::blend(from, to, alpha, dst, 3));
+        const int weight = static_cast<int>(alpha * 256.0f + 0.5f);
+        for(std::size_t i = 0; i < dst.size(); ++i) {
+            const int expected = (from[i] * (256 - weight) + to[i] * weight + 128) >> 8;
+            ASSERT_NEAR(dst[i], expected, 1) << "alpha " << alpha << " index " << i;
+        }
+    }
+}
+
+TEST(CrossFadePixels, FloatMatchesFormula) {
+    ofFloatPixels from, to, dst;
+    from.allocate(13, 5, 3);
+    to.allocate(13, 5, 3);
+    for(std::size_t i = 0; i < from.size(); ++i) {
+        from[i] = std::sin(static_cast<float>(i));
+        to[i] = std::cos(static_cast<float>(i));
+    }
+    ASSERT_TRUE(ofxCrossFadePixels::blend(from, to, 0.25f, dst, 2));
+    for(std::size_t i = 0; i < dst.size(); ++i) {
+        EXPECT_NEAR(dst[i], from[i] * 0.75f + to[i] * 0.25f, 1e-6f);
+    }
+}
+
+TEST(CrossFadePixels, DispatchesRowsToPool) {
+    ofPixels from, to, expected, dst;
+    from.allocate(64, 33, 4);
+    to.allocate(64, 33, 4);
+    for(std::size_t i = 0; i < from.size(); ++i) {
+        from[i] = static_cast<unsigned char>(i * 5);
+        to[i] = static_cast<unsigned char>(i * 11);
+    }
+    ASSERT_TRUE(ofxCrossFadePixels::blend(from, to, 0.7f, expected));
+    TaskPool pool(3);
+    for(int frame = 0; frame < 4; ++frame) {
+        dst.clear();
+        ASSERT_TRUE(ofxCrossFadePixels::blend(from, to, 0.7f, dst, 8, pool));
+        ASSERT_EQ(std::memcmp(dst.getData(), expected.getData(), dst.size()), 0) << "frame " << frame;
+    }
+    EXPECT_EQ(pool.numDispatches(), 4u);
+}
+
+TEST(CrossFadePixels, DispatchGetsAtMostOneTaskPerRow) {
+    ofFloatPixels from, to, dst;
+    from.allocate(3, 5, 1);
+    to.allocate(3, 5, 1);
+    for(std::size_t i = 0; i < from.size(); ++i) {
+        from[i] = 0.0f;
+        to[i] = static_cast<float>(i);
+    }
+    std::size_t num_dispatched = 0;
+    ASSERT_TRUE(ofxCrossFadePixels::blend(from, to, 0.5f, dst, 16, [&](std::size_t num_tasks, const auto &task) {
+        num_dispatched = num_tasks;
+        for(std::size_t i = 0; i < num_tasks; ++i) task(i);
+    }));
+    EXPECT_EQ(num_dispatched, 5u);
+    for(std::size_t i = 0; i < dst.size(); ++i) EXPECT_FLOAT_EQ(dst[i], i * 0.5f);
+}
+
+TEST(CrossFadePixels, RejectsMismatchedSize) {
+    ofPixels from, to, dst;
+    from.allocate(4, 4, 3);
+    to.allocate(4, 5, 3);
+    EXPECT_FALSE(ofxCrossFadePixels::blend(from, to, 0.5f, dst));
+}
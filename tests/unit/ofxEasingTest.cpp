@@ -0,0 +1,57 @@
+//
+//  ofxEasingTest.cpp
+//
+
+#include "ofxEasing.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+TEST(EasingCurve, TableIsCloseToFunction) {
+    for(std::size_t type = 0; type < static_cast<std::size_t>(ofx::Ease::NumEases); ++type) {
+        const auto ease = static_cast<ofx::Ease>(type);
+        // vertical ends of circ curves are documented exceptions (~2e-2)
+        const float tolerance = (ease == ofx::Ease::InCirc || ease == ofx::Ease::OutCirc) ? 2.5e-2f : 1e-3f;
+        const ofx::EasingCurve curve{ease};
+        for(int i = 0; i <= 1000; ++i) {
+            const float t = i / 1000.0f;
+            ASSERT_NEAR(curve(t), ofx::ease(ease, t), tolerance) << "type " << type << " t " << t;
+        }
+    }
+}
+
+TEST(EasingCurve, EndsAreExact) {
+    const ofx::EasingCurve curve{ofx::Ease::InOutCubic};
+    EXPECT_FLOAT_EQ(curve(0.0f), 0.0f);
+    EXPECT_FLOAT_EQ(curve(1.0f), 1.0f);
+    EXPECT_FLOAT_EQ(curve(-1.0f), 0.0f);
+    EXPECT_FLOAT_EQ(curve(2.0f), 1.0f);
+}
+
+TEST(EasingCurve, EvaluateMatchesScalar) {
+    const ofx::EasingCurve curve{ofx::CubicBezier{0.25f, 0.1f, 0.25f, 1.0f}};
+    std::vector<float> phases(37), values(37);
+    for(std::size_t i = 0; i < phases.size(); ++i) phases[i] = i / 30.0f - 0.1f;
+    curve.evaluate(phases.data(), values.data(), phases.size());
+    for(std::size_t i = 0; i < phases.size(); ++i) {
+        EXPECT_NEAR(values[i], curve(phases[i]), 1e-6f);
+    }
+}
+
+TEST(EasingCurve, AdvanceClampsPhase) {
+    const ofx::EasingCurve curve;
+    std::vector<float> phases{0.0f, 0.5f, 0.9f};
+    const std::vector<float> rates{1.0f, 2.0f, 1.0f};
+    std::vector<float> values(3);
+    curve.advance(phases.data(), rates.data(), 0.2f, values.data(), phases.size());
+    EXPECT_NEAR(phases[0], 0.2f, 1e-6f);
+    EXPECT_NEAR(phases[1], 0.9f, 1e-6f);
+    EXPECT_FLOAT_EQ(phases[2], 1.0f);
+    EXPECT_NEAR(values[1], 0.9f, 1e-6f);
+}
+
+TEST(CubicBezier, IsConstexpr) {
+    static constexpr auto table = ofx::makeEasingTable(ofx::CubicBezier{0.0f, 0.0f, 1.0f, 1.0f});
+    EXPECT_NEAR(table[128], 0.5f, 1e-3f);
+}
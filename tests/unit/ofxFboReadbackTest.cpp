@@ -0,0 +1,106 @@
+//
+//  ofxFboReadbackTest.cpp
+//
+//  needs headless GL context (see HeadlessGL.h). skipped without it.
+//
+
+#include "ofGraphics.h"
+#include "ofxFboReadback.h"
+
+#include "HeadlessGL.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+    struct FboReadbackRingTest : ::testing::Test {
+        void SetUp() override {
+            if(!ofStub::ensureHeadlessGL()) GTEST_SKIP() << ofStub::headlessGLDescription();
+            fbo.allocate(16, 8, GL_RGBA8);
+        }
+
+        // fills fbo with gray of value
+        void draw(int value) {
+            fbo.begin();
+            ofClear(value, value, value, 255);
+            fbo.end();
+        }
+
+        ofFbo fbo;
+    };
+};
+
+TEST_F(FboReadbackRingTest, GivesFramesInOrder) {
+    ofxFboReadbackRing readback;
+    readback.setup(3);
+    ofPixels pixels;
+    std::vector<int> received;
+    for(int frame = 0; frame < 10; ++frame) {
+        draw(frame * 10);
+        ASSERT_TRUE(readback.queue(fbo));
+        // keeps one readback in flight at least, like app which polls once per frame
+        if(readback.numInFlight() == readback.numBuffers() && readback.wait(pixels)) received.push_back(pixels[0]);
+    }
+    while(readback.wait(pixels)) {
+        EXPECT_EQ(pixels.getWidth(), 16u);
+        EXPECT_EQ(pixels.getHeight(), 8u);
+        EXPECT_EQ(pixels.getNumChannels(), 4u);
+        EXPECT_EQ(pixels[pixels.size() - 1], 255);
+        received.push_back(pixels[0]);
+    }
+    ASSERT_EQ(received.size(), 10u);
+    for(int frame = 0; frame < 10; ++frame) EXPECT_EQ(received[frame], frame * 10);
+
+    const auto &stats = readback.getStats();
+    EXPECT_EQ(stats.num_queued, 10u);
+    EXPECT_EQ(stats.num_completed, 10u);
+    EXPECT_EQ(stats.num_dropped, 0u);
+    EXPECT_EQ(stats.max_latency, 2u);
+    EXPECT_EQ(readback.numInFlight(), 0u);
+}
+
+TEST_F(FboReadbackRingTest, DropsWhenAllBuffersAreInFlight) {
+    ofxFboReadbackRing readback;
+    readback.setup(2);
+    draw(1);
+    EXPECT_TRUE(readback.queue(fbo));
+    draw(2);
+    EXPECT_TRUE(readback.queue(fbo));
+    draw(3);
+    EXPECT_FALSE(readback.queue(fbo));
+    EXPECT_EQ(readback.getStats().num_dropped, 1u);
+
+    ofPixels pixels;
+    ASSERT_TRUE(readback.wait(pixels));
+    EXPECT_EQ(pixels[0], 1);
+    EXPECT_EQ(readback.getStats().last_latency, 2u);
+    EXPECT_TRUE(readback.queue(fbo));
+}
+
+TEST_F(FboReadbackRingTest, RejectsMismatchedPixelType) {
+    ofxFboReadbackRing readback;
+    draw(1);
+    ASSERT_TRUE(readback.queue(fbo));
+    ofFloatPixels pixels;
+    EXPECT_FALSE(readback.wait(pixels));
+    EXPECT_EQ(readback.numInFlight(), 0u);
+    EXPECT_EQ(readback.getStats().num_completed, 0u);
+}
+
+TEST_F(FboReadbackRingTest, MatchesReadToPixels) {
+    ofxFboReadbackRing readback;
+    fbo.begin();
+    ofClear(0, 0, 0, 255);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(4, 2, 5, 3);
+    ofClear(200, 100, 50, 255);
+    glDisable(GL_SCISSOR_TEST);
+    fbo.end();
+    ofPixels expected, pixels;
+    fbo.readToPixels(expected);
+    ASSERT_TRUE(readback.queue(fbo));
+    ASSERT_TRUE(readback.wait(pixels));
+    ASSERT_EQ(pixels.size(), expected.size());
+    for(std::size_t i = 0; i < pixels.size(); ++i) ASSERT_EQ(pixels[i], expected[i]) << "at " << i;
+}
@@ -0,0 +1,102 @@
+//
+//  ofxInplaceFunctionTest.cpp
+//
+
+#include "ofxInplaceFunction.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace {
+    int twice(int x)
+    { return x * 2; }
+
+    struct Counter {
+        int add(int x)
+        { return value += x; }
+        int value{0};
+    };
+};
+
+TEST(InplaceFunction, CallsStoredCallable) {
+    int captured = 3;
+    ofxInplaceFunction<int(int)> f = [captured](int x) { return x + captured; };
+    ASSERT_TRUE(f);
+    EXPECT_EQ(f(4), 7);
+    f = twice;
+    EXPECT_EQ(f(4), 8);
+}
+
+TEST(InplaceFunction, VoidSignatureDiscardsResult) {
+    int called = 0;
+    ofxInplaceFunction<void(int)> f = [&called](int x) { called = x; return std::string("discarded"); };
+    f(5);
+    EXPECT_EQ(called, 5);
+    ofxInplaceFunction<void(int)> g = twice;
+    g(1);
+}
+
+TEST(InplaceFunction, OnlyAcceptsMatchingCallables) {
+    using function_type = ofxInplaceFunction<int(int)>;
+    EXPECT_TRUE((std::is_constructible<function_type, int (*)(int)>::value));
+    EXPECT_FALSE((std::is_constructible<function_type, void (*)(int)>::value));
+    EXPECT_FALSE((std::is_constructible<function_type, int (*)(const std::string &)>::value));
+    EXPECT_FALSE((std::is_constructible<function_type, int>::value));
+}
+
+TEST(InplaceFunction, NullCallableIsEmpty) {
+    int (*null_pointer)(int) = nullptr;
+    ofxInplaceFunction<int(int)> from_pointer = null_pointer;
+    EXPECT_FALSE(from_pointer);
+    EXPECT_THROW(from_pointer(1), std::bad_function_call);
+
+    ofxInplaceFunction<int(int)> from_function = std::function<int(int)>{};
+    EXPECT_FALSE(from_function);
+
+    int (Counter::*null_member)(int) = nullptr;
+    ofxInplaceFunction<int(Counter &, int)> from_member = null_member;
+    EXPECT_FALSE(from_member);
+
+    ofxInplaceFunction<int(int), 32> from_empty_inplace = ofxInplaceFunction<int(int), 16>{};
+    EXPECT_FALSE(from_empty_inplace);
+
+    ofxInplaceFunction<int(int)> from_function_with_target = std::function<int(int)>{twice};
+    ASSERT_TRUE(from_function_with_target);
+    EXPECT_EQ(from_function_with_target(2), 4);
+}
+
+TEST(InplaceFunction, CallsMemberPointer) {
+    Counter counter;
+    ofxInplaceFunction<int(Counter &, int)> f = &Counter::add;
+    f(counter, 2);
+    EXPECT_EQ(f(counter, 3), 5);
+}
+
+TEST(InplaceFunction, CopyAndMoveKeepCallable) {
+    auto value = std::make_shared<int>(7);
+    ofxInplaceFunction<int()> f = [value] { return *value; };
+    auto copied = f;
+    EXPECT_EQ(value.use_count(), 3);
+    auto moved = std::move(f);
+    EXPECT_FALSE(f);
+    EXPECT_EQ(moved(), 7);
+    EXPECT_EQ(copied(), 7);
+    moved = nullptr;
+    copied.reset();
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(InplaceFunction, MoveIsNoexcept) {
+    using function_type = ofxInplaceFunction<std::size_t(), 64>;
+    static_assert(std::is_nothrow_move_constructible<function_type>::value, "move is noexcept");
+    static_assert(std::is_nothrow_move_assignable<function_type>::value, "move is noexcept");
+    std::string captured(100, 'x');
+    function_type f = [captured] { return captured.size(); };
+    function_type g = std::move(f);
+    EXPECT_FALSE(f);
+    EXPECT_EQ(g(), 100u);
+}
@@ -0,0 +1,62 @@
+//
+//  ofxLockFreeQueueTest.cpp
+//
+
+#include "ofxLockFreeQueue.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(LockFreeQueue, CapacityIsRoundedUp) {
+    ofx::LockFreeQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+}
+
+TEST(LockFreeQueue, FifoAndDrop) {
+    ofx::LockFreeQueue<std::string> queue(4);
+    for(int i = 0; i < 6; ++i) queue.push(std::to_string(i));
+    EXPECT_EQ(queue.size(), 4u);
+    EXPECT_EQ(queue.numDropped(), 2u);
+    std::string value;
+    for(int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, std::to_string(i));
+    }
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(LockFreeQueue, DestroysRemainingValues) {
+    auto value = std::make_shared<int>(0);
+    {
+        ofx::LockFreeQueue<std::shared_ptr<int>> queue(4);
+        queue.push(value);
+        queue.push(value);
+        EXPECT_EQ(value.use_count(), 3);
+    }
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(LockFreeQueue, ManyProducers) {
+    constexpr int num_producers = 4;
+    constexpr int num_values = 20000;
+    ofx::LockFreeQueue<int> queue(1024);
+    std::vector<std::thread> producers;
+    for(int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&queue] {
+            for(int i = 0; i < num_values; ++i) {
+                while(!queue.push(1)) std::this_thread::yield();
+            }
+        });
+    }
+    int sum = 0, value;
+    while(sum < num_producers * num_values) {
+        if(queue.pop(value)) sum += value;
+    }
+    for(auto &producer : producers) producer.join();
+    EXPECT_EQ(sum, num_producers * num_values);
+    EXPECT_FALSE(queue.pop(value));
+}
@@ -0,0 +1,153 @@
+//
+//  ofxPingPongFboTest.cpp
+//
+//  needs headless GL context (see HeadlessGL.h). skipped without it.
+//
+
+#include "ofxPingPongFbo.h"
+
+#include "HeadlessGL.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+    struct PingPongFboTest : ::testing::Test {
+        void SetUp() override {
+            if(!ofStub::ensureHeadlessGL()) GTEST_SKIP() << ofStub::headlessGLDescription();
+            settings.width = 16;
+            settings.height = 8;
+            settings.internalformat = GL_RGBA8;
+        }
+
+        ofFboSettings settings;
+    };
+
+    using FboPoolTest = PingPongFboTest;
+};
+
+TEST_F(PingPongFboTest, IndexMath) {
+    ofx::FboPool pool;
+    ofxPingPongFbo fbo;
+    fbo.allocate(settings, 3, pool);
+    fbo.setAutomaticallyNextWithEnd(true);
+    ASSERT_EQ(fbo.size(), 3u);
+    EXPECT_EQ(fbo.current(), 0u);
+    const ofFbo *fbos[] = {&fbo[0], &fbo[1], &fbo[2]};
+    EXPECT_EQ(&fbo.prevFbo(), fbos[2]);
+    EXPECT_EQ(&fbo.prevFbo(4), fbos[2]);
+    EXPECT_EQ(&fbo[-1], fbos[2]);
+    EXPECT_EQ(&fbo[-4], fbos[2]);
+
+    fbo.begin();
+    fbo.end();
+    EXPECT_EQ(fbo.current(), 1u);
+    EXPECT_EQ(&fbo.currentFbo(), fbos[1]);
+    EXPECT_EQ(&fbo.prevFbo(), fbos[0]);
+    fbo.end(false);
+    EXPECT_EQ(fbo.current(), 1u);
+    fbo.next();
+    fbo.next();
+    EXPECT_EQ(fbo.current(), 0u);
+}
+
+TEST_F(PingPongFboTest, LeasesLazily) {
+    ofx::FboPool pool;
+    ofxPingPongFbo fbo;
+    fbo.allocate(settings, 2, pool);
+    EXPECT_EQ(fbo.numLeased(), 0u);
+    EXPECT_FLOAT_EQ(fbo.getWidth(), 16.0f);
+    fbo.begin();
+    fbo.end();
+    EXPECT_EQ(fbo.numLeased(), 1u);
+    EXPECT_EQ(pool.getStats().num_leased, 1u);
+    fbo.release();
+    EXPECT_EQ(fbo.numLeased(), 0u);
+    EXPECT_EQ(pool.getStats().num_free, 1u);
+}
+
+TEST_F(FboPoolTest, ReusesSameSettings) {
+    ofx::FboPool pool;
+    {
+        auto a = pool.lease(settings);
+        auto b = pool.lease(settings);
+        EXPECT_NE(a.get(), b.get());
+    }
+    auto c = pool.lease(settings);
+    const auto &stats = pool.getStats();
+    EXPECT_EQ(stats.num_allocations, 2u);
+    EXPECT_EQ(stats.num_reuses, 1u);
+    EXPECT_EQ(stats.num_leased, 1u);
+    EXPECT_EQ(stats.bytes_in_use, 16u * 8u * 4u);
+    EXPECT_EQ(stats.max_bytes_in_use, 2u * 16u * 8u * 4u);
+
+    auto other_settings = settings;
+    other_settings.width = 32;
+    auto d = pool.lease(other_settings);
+    EXPECT_EQ(pool.getStats().num_allocations, 3u);
+
+    pool.purge();
+    EXPECT_EQ(pool.getStats().num_free, 0u);
+    EXPECT_EQ(pool.getStats().bytes_free, 0u);
+}
+
+TEST_F(FboPoolTest, LeaseOutlivesPool) {
+    ofx::FboPool::Lease lease;
+    {
+        ofx::FboPool pool;
+        lease = pool.lease(settings);
+    }
+    EXPECT_TRUE(lease->isAllocated());
+    lease.reset();
+}
+
+TEST_F(PingPongFboTest, ConstAccessDoesNotLease) {
+    ofx::FboPool pool;
+    ofxPingPongFbo fbo;
+    fbo.allocate(settings, 2, pool);
+    const auto &const_fbo = fbo;
+    const_fbo.draw(0, 0);
+    EXPECT_FALSE(const_fbo.getTexture().isAllocated());
+    ofPixels pixels;
+    const_fbo.readToPixels(pixels);
+    EXPECT_FALSE(pixels.isAllocated());
+    EXPECT_FALSE(const_fbo[1].isAllocated());
+    EXPECT_EQ(fbo.numLeased(), 0u);
+    EXPECT_EQ(pool.getStats().num_leased, 0u);
+}
+
+TEST_F(PingPongFboTest, UsableBeforeAllocate) {
+    ofxPingPongFbo fbo;
+    fbo.begin();
+    fbo.end();
+    fbo.next();
+    fbo.draw(0, 0);
+    EXPECT_FALSE(fbo.getTexture().isAllocated());
+    EXPECT_FALSE(fbo[-1].isAllocated());
+    EXPECT_FALSE(fbo.prevFbo().isAllocated());
+    EXPECT_EQ(fbo.size(), 0u);
+    EXPECT_EQ(fbo.numLeased(), 0u);
+}
+
+TEST_F(PingPongFboTest, CopyLeasesOwnBuffers) {
+    ofx::FboPool pool;
+    ofxPingPongFbo fbo;
+    fbo.allocate(settings, 3, pool);
+    fbo.setupAsyncReadback(2);
+    fbo.begin();
+    fbo.end();
+    fbo.next();
+
+    ofxPingPongFbo copied = fbo;
+    EXPECT_EQ(copied.size(), 3u);
+    EXPECT_EQ(copied.current(), 1u);
+    EXPECT_EQ(copied.numLeased(), 0u);
+    EXPECT_NE(&copied.getAsyncReadback(), &fbo.getAsyncReadback());
+    EXPECT_EQ(copied.getAsyncReadback().numBuffers(), 2u);
+    EXPECT_NE(&copied[-1], &fbo[-1]);
+    EXPECT_EQ(pool.getStats().num_leased, 2u);
+
+    ofxPingPongFbo assigned;
+    assigned = copied;
+    EXPECT_EQ(assigned.size(), 3u);
+    EXPECT_EQ(assigned.numLeased(), 0u);
+}
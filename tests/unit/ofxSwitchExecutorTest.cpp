@@ -0,0 +1,309 @@
+//
+//  ofxSwitchExecutorTest.cpp
+//
+
+#include "ofxSwitchExecutor.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    enum class Mode {
+        A,
+        B,
+        C,
+        D
+    };
+};
+
+TEST(SwitchExecutor, RunsHandlerOfValue) {
+    ofxSwitchExecutor<Mode> executor;
+    std::vector<Mode> called;
+    executor.action(Mode::A, [&] { called.push_back(Mode::A); });
+    executor.action(Mode::C, [&] { called.push_back(Mode::C); });
+    executor.run(Mode::C);
+    executor.run(Mode::A);
+    executor.run(Mode::B);
+    EXPECT_EQ(called, (std::vector<Mode>{Mode::C, Mode::A}));
+    EXPECT_TRUE(executor.isDense());
+}
+
+TEST(SwitchExecutor, FallbackAndRemove) {
+    ofxSwitchExecutor<Mode> executor;
+    int num_fallbacks = 0, num_a = 0;
+    executor.action(Mode::A, [&] { ++num_a; });
+    executor.fallback([&] { ++num_fallbacks; });
+    executor.run(Mode::D);
+    executor.remove(Mode::A);
+    executor.run(Mode::A);
+    EXPECT_EQ(num_a, 0);
+    EXPECT_EQ(num_fallbacks, 2);
+}
+
+TEST(SwitchExecutor, ForwardsArgumentsAndResult) {
+    ofxSwitchExecutor<int, int(int, const std::string &)> executor;
+    executor.action(1, [](int x, const std::string &s) { return x + static_cast<int>(s.size()); });
+    EXPECT_EQ(executor.run(1, 10, "abc"), 13);
+    EXPECT_EQ(executor.run(2, 10, "abc"), 0);
+}
+
+TEST(SwitchExecutor, SparseKeysUseMap) {
+    ofxSwitchExecutor<int, int()> executor;
+    executor.action(0, [] { return 1; });
+    executor.action(1 << 20, [] { return 2; });
+    executor.action(-5, [] { return 3; });
+    EXPECT_FALSE(executor.isDense());
+    EXPECT_EQ(executor.run(1 << 20), 2);
+    EXPECT_EQ(executor.run(-5), 3);
+    EXPECT_EQ(executor.run(7), 0);
+}
+
+TEST(SwitchExecutor, DenseTableRejectsOutOfRange) {
+    ofxSwitchExecutor<int, int()> executor;
+    for(int i = 100; i < 110; ++i) executor.action(i, [i] { return i; });
+    EXPECT_TRUE(executor.isDense());
+    EXPECT_EQ(executor.run(105), 105);
+    EXPECT_EQ(executor.run(99), 0);
+    EXPECT_EQ(executor.run(110), 0);
+    EXPECT_EQ(executor.run(-1), 0);
+}
+
+TEST(SwitchExecutor, CopyHasOwnTable) {
+    ofxSwitchExecutor<int, int()> executor;
+    executor.action(0, [] { return 1; });
+    auto copied = executor;
+    executor.action(0, [] { return 2; });
+    EXPECT_EQ(copied.run(0), 1);
+    EXPECT_EQ(executor.run(0), 2);
+}
+
+TEST(SwitchExecutor, FlushGroupsByKeyAndKeepsOrder) {
+    ofxSwitchExecutor<Mode, void(int)> executor;
+    std::vector<std::pair<Mode, int>> called;
+    executor.action(Mode::A, [&](int x) { called.emplace_back(Mode::A, x); });
+    executor.action(Mode::B, [&](int x) { called.emplace_back(Mode::B, x); });
+    executor.enqueue(Mode::B, 0);
+    executor.enqueue(Mode::A, 1);
+    executor.enqueue(Mode::B, 2);
+    executor.enqueue(Mode::A, 3);
+    EXPECT_EQ(executor.numQueued(), 4u);
+    executor.flush();
+    EXPECT_EQ(executor.numQueued(), 0u);
+    EXPECT_EQ(called, (std::vector<std::pair<Mode, int>>{{Mode::A, 1}, {Mode::A, 3}, {Mode::B, 0}, {Mode::B, 2}}));
+}
+
+TEST(SwitchExecutor, FlushParallelRunsEveryEvent) {
+    ofxSwitchExecutor<int, void(int)> executor;
+    std::atomic<int> sum{0};
+    for(int key = 0; key < 8; ++key) executor.action(key, [&](int x) { sum += x; });
+    int expected = 0;
+    for(int i = 0; i < 1000; ++i) {
+        executor.enqueue(i % 10, i);
+        if(i % 10 < 8) expected += i;
+    }
+    int fallback_sum = 0;
+    executor.fallback([&](int x) { fallback_sum += x; });
+    executor.flushParallel(std::size_t{4});
+    EXPECT_EQ(sum.load(), expected);
+    EXPECT_EQ(fallback_sum, 999 * 1000 / 2 - expected);
+}
+
+TEST(SwitchExecutor, RunBatchCallsOncePerValue) {
+    ofxSwitchExecutor<Mode> executor;
+    int num_a = 0, num_b = 0;
+    executor.action(Mode::A, [&] { ++num_a; });
+    executor.action(Mode::B, [&] { ++num_b; });
+    const std::vector<Mode> values{Mode::A, Mode::B, Mode::A, Mode::C, Mode::A};
+    executor.runBatch(values);
+    EXPECT_EQ(num_a, 3);
+    EXPECT_EQ(num_b, 1);
+}
+
+TEST(SwitchExecutor, RunBatchCopiesByValueArgumentsAndMovesLast) {
+    struct Tracked {
+        explicit Tracked(int *num_copies)
+        : num_copies{num_copies}
+        {}
+        Tracked(const Tracked &x)
+        : num_copies{x.num_copies}
+        { ++*num_copies; }
+        Tracked(Tracked &&) = default;
+        int *num_copies;
+    };
+    ofxSwitchExecutor<Mode, void(Tracked, std::string &&, int &)> executor;
+    std::vector<std::string> received;
+    executor.action(Mode::A, [&](Tracked, std::string &&s, int &count) {
+        received.push_back(std::move(s));
+        ++count;
+    });
+    int num_copies = 0, count = 0;
+    const std::vector<Mode> values{Mode::A, Mode::A, Mode::A};
+    executor.runBatch(values, Tracked{&num_copies}, "abc", count);
+    EXPECT_EQ(num_copies, 2);
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(received, (std::vector<std::string>{"abc", "abc", "abc"}));
+}
+
+TEST(SwitchExecutor, FlushMovesQueuedArguments) {
+    ofxSwitchExecutor<Mode, void(std::unique_ptr<int>), 32> executor;
+    int sum = 0;
+    executor.action(Mode::A, [&](std::unique_ptr<int> x) { sum += *x; });
+    executor.enqueue(Mode::A, std::make_unique<int>(1));
+    executor.enqueue(Mode::A, std::make_unique<int>(2));
+    executor.flush();
+    EXPECT_EQ(sum, 3);
+}
+
+TEST(SwitchExecutor, HandlerOfFlushCanRunBatch) {
+    ofxSwitchExecutor<Mode, void(int)> executor;
+    int num_calls = 0;
+    const std::vector<Mode> values(18, Mode::B);
+    executor.action(Mode::A, [&](int) {
+        ++num_calls;
+        executor.runBatch(values, 0);
+    });
+    executor.action(Mode::B, [&](int) { ++num_calls; });
+    executor.enqueue(Mode::B, 0);
+    executor.enqueue(Mode::A, 1);
+    executor.flush();
+    EXPECT_EQ(num_calls, 20);
+}
+
+TEST(SwitchExecutor, HandlerOfFlushCanFlush) {
+    ofxSwitchExecutor<Mode, void(int)> executor;
+    std::vector<int> called;
+    executor.action(Mode::A, [&](int x) {
+        called.push_back(x);
+        if(x == 0) {
+            executor.enqueue(Mode::B, 10);
+            executor.flush();
+        }
+    });
+    executor.action(Mode::B, [&](int x) { called.push_back(x); });
+    executor.enqueue(Mode::A, 0);
+    executor.enqueue(Mode::A, 1);
+    executor.enqueue(Mode::B, 2);
+    executor.flush();
+    EXPECT_EQ(called, (std::vector<int>{0, 10, 1, 2}));
+    EXPECT_EQ(executor.numQueued(), 0u);
+}
+
+TEST(SwitchExecutor, InstrumentationCountsCalls) {
+    ofxInstrumentedSwitchExecutor<Mode> executor;
+    executor.action(Mode::A, [] {});
+    for(int i = 0; i < 10; ++i) executor.run(Mode::A);
+    executor.run(Mode::B);
+    const auto snapshot = executor.getInstrumentation().snapshot();
+    EXPECT_EQ(snapshot.keys.at(Mode::A).num_calls, 10u);
+    EXPECT_EQ(snapshot.numFallbacks(), 1u);
+    EXPECT_EQ(snapshot.numCalls(), 11u);
+}
+
+TEST(ConcurrentSwitchExecutor, UpdateWhileRunning) {
+    ofxConcurrentSwitchExecutor<int, int()> executor;
+    executor.action(0, [] { return 1; });
+    std::atomic<bool> is_running{true};
+    std::atomic<std::uint64_t> num_runs{0};
+    std::thread reader([&] {
+        while(is_running) {
+            const int result = executor.run(0);
+            EXPECT_TRUE(result == 1 || result == 2);
+            ++num_runs;
+        }
+    });
+    for(int i = 0; i < 200; ++i) executor.action(0, [i] { return 1 + i % 2; });
+    is_running = false;
+    reader.join();
+    EXPECT_EQ(executor.numUpdates(), 201u);
+    EXPECT_EQ(executor.numRetired(), 0u);
+}
+
+TEST(ConcurrentSwitchExecutor, HandlerCanModifyOnSameThread) {
+    ofxConcurrentSwitchExecutor<int> executor;
+    int num_b = 0;
+    executor.action(0, [&] { executor.action(1, [&] { ++num_b; }); });
+    executor.run(0);
+    executor.run(1);
+    EXPECT_EQ(num_b, 1);
+    EXPECT_EQ(executor.numRetired(), 1u);
+}
+
+TEST(ConcurrentSwitchExecutor, HandlerCanModifyWhileOtherThreadWaits) {
+    // T1 runs handler of 0, which modifies executor while T2 waits for T1 in grace period of remove(1).
+    // threads are detached and share executor, so failing test doesn't hang.
+    auto executor = std::make_shared<ofxConcurrentSwitchExecutor<int>>();
+    auto is_entered = std::make_shared<std::promise<void>>();
+    auto is_done = std::make_shared<std::promise<void>>();
+    executor->action(0, [executor = executor.get(), is_entered] {
+        is_entered->set_value();
+        while(executor->numUpdates() < 3) std::this_thread::yield();
+        executor->action(1, [] {});
+    });
+    executor->action(1, [] {});
+    std::thread([executor, is_done] {
+        executor->run(0);
+        is_done->set_value();
+    }).detach();
+    is_entered->get_future().wait();
+    auto is_removed = std::async(std::launch::async, [executor] { executor->remove(1); });
+    const auto is_finished = is_done->get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready
+                          && is_removed.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    if(!is_finished) {
+        new std::future<void>(std::move(is_removed)); // leaked on purpose, its destructor would wait forever
+        FAIL() << "deadlock between handler and update() on other thread";
+    }
+    EXPECT_EQ(executor->numUpdates(), 4u);
+}
+
+TEST(StaticSwitchExecutor, RunsCompileTimeHandlers) {
+    int called = -1;
+    const auto executor = ofxStaticSwitchExecutor<Mode, Mode::A, Mode::B>{}
+        .action<Mode::A>([&] { called = 0; })
+        .action<Mode::B>([&] { called = 1; })
+        .fallback([&] { called = 9; });
+    executor.run(Mode::B);
+    EXPECT_EQ(called, 1);
+    executor.run(Mode::D);
+    EXPECT_EQ(called, 9);
+}
+
+TEST(SwitchExecutor, DefaultStorageAcceptsLargeCaptures) {
+    const std::string a(100, 'a'), b(100, 'b'), c(100, 'c');
+    ofxSwitchExecutor<Mode, std::size_t()> executor;
+    executor.action(Mode::A, [a, b, c] { return a.size() + b.size() + c.size(); });
+    EXPECT_EQ(executor.run(Mode::A), 300u);
+    static_assert(std::is_same<decltype(executor)::function_type, std::function<std::size_t()>>::value,
+                  "default handler storage is std::function");
+}
+
+TEST(SwitchExecutor, InlineStorageWhenCapacityIsGiven) {
+    ofxSwitchExecutor<Mode, int(int), 32> executor;
+    static_assert(std::is_same<decltype(executor)::function_type, ofxInplaceFunction<int(int), 32>>::value,
+                  "handlers are stored inline");
+    const int offset = 10;
+    executor.action(Mode::A, [offset](int x) { return x + offset; });
+    EXPECT_EQ(executor.run(Mode::A, 1), 11);
+}
+
+TEST(SwitchExecutor, VoidHandlerMayReturnValue) {
+    ofxSwitchExecutor<Mode, void(int &), 16> executor;
+    executor.action(Mode::A, [](int &x) { return ++x; });
+    int x = 0;
+    executor.run(Mode::A, x);
+    EXPECT_EQ(x, 1);
+}
+
+TEST(SwitchExecutor, EmptyHandlerRunsNothing) {
+    ofxSwitchExecutor<Mode, int(), 64> executor;
+    executor.fallback(std::function<int()>{});
+    EXPECT_EQ(executor.run(Mode::A), 0);
+}